@@ -0,0 +1,339 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#include "Zakazane/AsyncInstrumentation.h"
+
+#if ZKZ_WITH_ASYNC_INSTRUMENTATION
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeRWLock.h"
+#include "ProfilingDebugging/CounterTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+#include <atomic>
+
+UE_TRACE_CHANNEL_DEFINE(ZkzAsyncChannel)
+
+TRACE_DECLARE_INT_COUNTER(ZkzAsyncPendingPromises, TEXT("Zkz/Async/PendingPromises"));
+
+namespace Zkz::AsyncInstrumentation
+{
+
+namespace
+{
+
+bool bInstrumentationEnabled = false;
+
+FAutoConsoleVariableRef CVarInstrumentationEnabled{
+	TEXT("Zkz.Async.Instrumentation"),
+	bInstrumentationEnabled,
+	TEXT("Enables recording latency stats of tagged promises and instrumented futures and continuations."),
+	ECVF_Default};
+
+void AtomicAdd(std::atomic<double>& Atomic, const double Value)
+{
+	double Expected = Atomic.load(std::memory_order_relaxed);
+	while (!Atomic.compare_exchange_weak(Expected, Expected + Value, std::memory_order_relaxed))
+	{
+	}
+}
+
+void AtomicMax(std::atomic<double>& Atomic, const double Value)
+{
+	double Expected = Atomic.load(std::memory_order_relaxed);
+	while (Expected < Value && !Atomic.compare_exchange_weak(Expected, Value, std::memory_order_relaxed))
+	{
+	}
+}
+
+/// FDurationStats that may be added to from multiple threads without locking.
+struct FAtomicDurationStats
+{
+	void Add(const double Seconds)
+	{
+		const uint64 Microseconds = static_cast<uint64>(FMath::Max(Seconds, 0.0) * 1'000'000.0);
+		const int32 BucketIdx =
+			FMath::Min<int32>(FMath::FloorLog2_64(FMath::Max<uint64>(Microseconds, 1)), FDurationStats::NumBuckets - 1);
+
+		Buckets[BucketIdx].fetch_add(1, std::memory_order_relaxed);
+		Count.fetch_add(1, std::memory_order_relaxed);
+		AtomicAdd(TotalSeconds, Seconds);
+		AtomicMax(MaxSeconds, Seconds);
+	}
+
+	FDurationStats GetSnapshot() const
+	{
+		FDurationStats Snapshot;
+		for (int32 BucketIdx = 0; BucketIdx < FDurationStats::NumBuckets; ++BucketIdx)
+		{
+			Snapshot.Buckets[BucketIdx] = Buckets[BucketIdx].load(std::memory_order_relaxed);
+		}
+
+		Snapshot.Count = Count.load(std::memory_order_relaxed);
+		Snapshot.TotalSeconds = TotalSeconds.load(std::memory_order_relaxed);
+		Snapshot.MaxSeconds = MaxSeconds.load(std::memory_order_relaxed);
+		return Snapshot;
+	}
+
+	void Reset()
+	{
+		for (std::atomic<uint64>& Bucket : Buckets)
+		{
+			Bucket.store(0, std::memory_order_relaxed);
+		}
+
+		Count.store(0, std::memory_order_relaxed);
+		TotalSeconds.store(0.0, std::memory_order_relaxed);
+		MaxSeconds.store(0.0, std::memory_order_relaxed);
+	}
+
+	std::atomic<uint64> Buckets[FDurationStats::NumBuckets] = {};
+
+	std::atomic<uint64> Count = 0;
+
+	std::atomic<double> TotalSeconds = 0.0;
+
+	std::atomic<double> MaxSeconds = 0.0;
+};
+
+struct FAtomicTagStats
+{
+	FTagStats GetSnapshot() const
+	{
+		FTagStats Snapshot;
+		Snapshot.FulfilmentLatency = FulfilmentLatency.GetSnapshot();
+		Snapshot.CancellationLatency = CancellationLatency.GetSnapshot();
+		Snapshot.ContinuationTime = ContinuationTime.GetSnapshot();
+		Snapshot.NumPending = NumPending.load(std::memory_order_relaxed);
+		return Snapshot;
+	}
+
+	void Reset()
+	{
+		FulfilmentLatency.Reset();
+		CancellationLatency.Reset();
+		ContinuationTime.Reset();
+		NumPending.store(0, std::memory_order_relaxed);
+	}
+
+	FAtomicDurationStats FulfilmentLatency;
+
+	FAtomicDurationStats CancellationLatency;
+
+	FAtomicDurationStats ContinuationTime;
+
+	std::atomic<int64> NumPending = 0;
+};
+
+/// Stats are only ever added, never removed (resetting zeroes them), so their addresses stay valid for the lifetime of
+/// the process and may be cached by recording threads.
+struct FStatsRegistry
+{
+	static FStatsRegistry& Get()
+	{
+		static FStatsRegistry Instance;
+		return Instance;
+	}
+
+	FRWLock Lock;
+
+	TMap<FName, TUniquePtr<FAtomicTagStats>> StatsByTag;
+};
+
+/// Looks the tag up in a per-thread cache first, so recording only locks the registry on the first use of a tag on
+/// a thread.
+FAtomicTagStats& FindOrAddTagStats(const FName Tag)
+{
+	thread_local TMap<FName, FAtomicTagStats*> CachedStatsByTag;
+	if (FAtomicTagStats* const* CachedStats = CachedStatsByTag.Find(Tag))
+	{
+		return **CachedStats;
+	}
+
+	FStatsRegistry& Registry = FStatsRegistry::Get();
+
+	FAtomicTagStats* Stats = nullptr;
+	{
+		FReadScopeLock Lock{Registry.Lock};
+		if (const TUniquePtr<FAtomicTagStats>* ExistingStats = Registry.StatsByTag.Find(Tag))
+		{
+			Stats = ExistingStats->Get();
+		}
+	}
+
+	if (Stats == nullptr)
+	{
+		FWriteScopeLock Lock{Registry.Lock};
+
+		TUniquePtr<FAtomicTagStats>& NewStats = Registry.StatsByTag.FindOrAdd(Tag);
+		if (!NewStats.IsValid())
+		{
+			NewStats = MakeUnique<FAtomicTagStats>();
+		}
+
+		Stats = NewStats.Get();
+	}
+
+	CachedStatsByTag.Add(Tag, Stats);
+	return *Stats;
+}
+
+FAutoConsoleCommandWithOutputDevice DumpStatsCommand{
+	TEXT("Zkz.Async.DumpStats"),
+	TEXT("Prints latency stats of tagged promises and instrumented futures and continuations."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&DumpStats)};
+
+FAutoConsoleCommand ResetStatsCommand{
+	TEXT("Zkz.Async.ResetStats"),
+	TEXT("Clears latency stats of tagged promises and instrumented futures and continuations."),
+	FConsoleCommandDelegate::CreateStatic(&ResetStats)};
+
+}  // namespace
+
+bool IsEnabled()
+{
+	return bInstrumentationEnabled;
+}
+
+void RecordPending(const FName Tag)
+{
+	TRACE_COUNTER_INCREMENT(ZkzAsyncPendingPromises);
+	FindOrAddTagStats(Tag).NumPending.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RecordFulfilment(const FName Tag, const double LatencySeconds)
+{
+	TRACE_COUNTER_DECREMENT(ZkzAsyncPendingPromises);
+
+	FAtomicTagStats& Stats = FindOrAddTagStats(Tag);
+	Stats.NumPending.fetch_sub(1, std::memory_order_relaxed);
+	Stats.FulfilmentLatency.Add(LatencySeconds);
+}
+
+void RecordCancellation(const FName Tag, const double LatencySeconds)
+{
+	TRACE_COUNTER_DECREMENT(ZkzAsyncPendingPromises);
+
+	FAtomicTagStats& Stats = FindOrAddTagStats(Tag);
+	Stats.NumPending.fetch_sub(1, std::memory_order_relaxed);
+	Stats.CancellationLatency.Add(LatencySeconds);
+}
+
+void RecordContinuation(const FName Tag, const double ExecutionSeconds)
+{
+	FindOrAddTagStats(Tag).ContinuationTime.Add(ExecutionSeconds);
+}
+
+TMap<FName, FTagStats> GetStats()
+{
+	FStatsRegistry& Registry = FStatsRegistry::Get();
+
+	FReadScopeLock Lock{Registry.Lock};
+
+	TMap<FName, FTagStats> Stats;
+	Stats.Reserve(Registry.StatsByTag.Num());
+	for (const TPair<FName, TUniquePtr<FAtomicTagStats>>& TagStats : Registry.StatsByTag)
+	{
+		Stats.Add(TagStats.Key, TagStats.Value->GetSnapshot());
+	}
+
+	return Stats;
+}
+
+void DumpStats(FOutputDevice& Output)
+{
+	TMap<FName, FTagStats> StatsByTag = GetStats();
+	StatsByTag.KeySort(FNameLexicalLess{});
+
+	Output.Logf(
+		TEXT("Async instrumentation stats (%s):"), bInstrumentationEnabled ? TEXT("recording") : TEXT("not recording"));
+
+	for (const TPair<FName, FTagStats>& TagStats : StatsByTag)
+	{
+		const FTagStats& Stats = TagStats.Value;
+
+		Output.Logf(TEXT("  %s: pending=%lld"), *TagStats.Key.ToString(), Stats.NumPending);
+		Output.Logf(TEXT("    fulfilled:    %s"), *Stats.FulfilmentLatency.ToString());
+		Output.Logf(TEXT("    cancelled:    %s"), *Stats.CancellationLatency.ToString());
+		Output.Logf(TEXT("    continuation: %s"), *Stats.ContinuationTime.ToString());
+	}
+}
+
+void ResetStats()
+{
+	FStatsRegistry& Registry = FStatsRegistry::Get();
+
+	FReadScopeLock Lock{Registry.Lock};
+	for (const TPair<FName, TUniquePtr<FAtomicTagStats>>& TagStats : Registry.StatsByTag)
+	{
+		TagStats.Value->Reset();
+	}
+}
+
+double FDurationStats::GetPercentileUpperBound(const double Percentile) const
+{
+	const uint64 Threshold = static_cast<uint64>(FMath::CeilToDouble(Count * Percentile));
+
+	uint64 Cumulative = 0;
+	for (int32 BucketIdx = 0; BucketIdx < NumBuckets; ++BucketIdx)
+	{
+		Cumulative += Buckets[BucketIdx];
+		if (Cumulative >= Threshold)
+		{
+			return FMath::Min(static_cast<double>(uint64{1} << (BucketIdx + 1)) / 1'000'000.0, MaxSeconds);
+		}
+	}
+
+	return MaxSeconds;
+}
+
+FString FDurationStats::ToString() const
+{
+	if (Count == 0)
+	{
+		return TEXT("-");
+	}
+
+	return FString::Printf(
+		TEXT("n=%llu mean=%.3fms p50<=%.3fms p90<=%.3fms p99<=%.3fms max=%.3fms"),
+		Count,
+		TotalSeconds / Count * 1000.0,
+		GetPercentileUpperBound(0.5) * 1000.0,
+		GetPercentileUpperBound(0.9) * 1000.0,
+		GetPercentileUpperBound(0.99) * 1000.0,
+		MaxSeconds * 1000.0);
+}
+
+FContinuationScope::FContinuationScope(const FName InTag) : Tag{InTag}
+{
+#if CPUPROFILERTRACE_ENABLED
+	if (UE_TRACE_CHANNELEXPR_IS_ENABLED(ZkzAsyncChannel))
+	{
+		FCpuProfilerTrace::OutputBeginDynamicEvent(*Tag.ToString());
+		bTraceEventStarted = true;
+	}
+#endif
+
+	if (IsEnabled())
+	{
+		StartTime = FPlatformTime::Seconds();
+	}
+}
+
+FContinuationScope::~FContinuationScope()
+{
+	if (StartTime > 0.0)
+	{
+		RecordContinuation(Tag, FPlatformTime::Seconds() - StartTime);
+	}
+
+#if CPUPROFILERTRACE_ENABLED
+	if (bTraceEventStarted)
+	{
+		FCpuProfilerTrace::OutputEndEvent();
+	}
+#endif
+}
+
+}  // namespace Zkz::AsyncInstrumentation
+
+#endif
@@ -0,0 +1,821 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#include "Zakazane/BinaryLog.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/App.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+#include "Zakazane/ReturnIfMacros.h"
+
+#include <bit>
+#include <cstdarg>
+
+namespace Zkz::BinaryLog::Private
+{
+
+std::atomic<bool> bRecording{false};
+
+// -- File format
+//
+// Header, followed by records. Each record starts with its ERecordType:
+//   String: uint32 Id, uint32 NumChars, TCHAR[NumChars] - category name or format string, precedes its first use
+//   Entries: uint32 ThreadId, uint32 NumBytes, entries recorded by the thread
+// Entry: uint32 Size, uint64 Cycles, uint32 CategoryId, uint8 Verbosity, uint32 FormatId, uint8 NumArgs, args
+// Arg: EArgType, followed by int64 / uint64 / double / uint64 pointer, or uint32 NumChars and the chars for strings
+
+constexpr ANSICHAR FileMagic[8] = {'Z', 'K', 'Z', 'B', 'L', 'O', 'G', '\0'};
+
+constexpr uint32 FileVersion = 1;
+
+struct FFileHeader
+{
+	ANSICHAR Magic[8];
+	uint32 Version;
+	uint32 CharSize;
+	double SecondsPerCycle;
+	uint64 StartCycles;
+	int64 StartUtcTicks;
+};
+
+enum class ERecordType : uint8
+{
+	String = 1,
+	Entries = 2,
+};
+
+/// Single producer (the owning thread), single consumer (whoever holds the file lock) byte ring
+struct FThreadBuffer
+{
+	static constexpr uint32 Capacity = 64 * 1024;
+
+	explicit FThreadBuffer(const uint32 InThreadId) : ThreadId{InThreadId}
+	{
+	}
+
+	bool TryWrite(const uint8* const Source, const uint32 Size)
+	{
+		const uint64 WriteHead = Head.load(std::memory_order_relaxed);
+		const uint64 ReadTail = Tail.load(std::memory_order_acquire);
+		ZKZ_RETURN_IF(Capacity - (WriteHead - ReadTail) < Size, false);
+
+		const uint32 Offset = static_cast<uint32>(WriteHead % Capacity);
+		const uint32 FirstPart = FMath::Min(Size, Capacity - Offset);
+		FMemory::Memcpy(Data + Offset, Source, FirstPart);
+		FMemory::Memcpy(Data, Source + FirstPart, Size - FirstPart);
+
+		Head.store(WriteHead + Size, std::memory_order_release);
+		return true;
+	}
+
+	void Read(TArray<uint8>& OutBytes)
+	{
+		const uint64 WriteHead = Head.load(std::memory_order_acquire);
+		const uint64 ReadTail = Tail.load(std::memory_order_relaxed);
+		const uint32 Size = static_cast<uint32>(WriteHead - ReadTail);
+		ZKZ_RETURN_IF(Size == 0);
+
+		const uint32 Offset = static_cast<uint32>(ReadTail % Capacity);
+		const uint32 FirstPart = FMath::Min(Size, Capacity - Offset);
+		OutBytes.Append(Data + Offset, FirstPart);
+		OutBytes.Append(Data, Size - FirstPart);
+
+		Tail.store(WriteHead, std::memory_order_release);
+	}
+
+	/// Consumer side, drops everything not read yet
+	void Discard()
+	{
+		Tail.store(Head.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+	const uint32 ThreadId;
+
+	/// Set when the owning thread exits, the consumer frees the buffer once it read the rest of it
+	std::atomic<bool> bRetired{false};
+
+	std::atomic<uint64> Head{0};
+
+	std::atomic<uint64> Tail{0};
+
+	uint8 Data[Capacity];
+};
+
+class FWriter;
+
+struct FState
+{
+	/// Guards the buffer registry and string interning
+	FCriticalSection RegistryCriticalSection;
+
+	/// A thread keeps its buffer for its lifetime, the buffer is freed after the thread exits and it's drained
+	TArray<TUniquePtr<FThreadBuffer>> Buffers;
+
+	TMap<const TCHAR*, uint32> FormatIds;
+
+	TMap<FName, uint32> CategoryIds;
+
+	/// Interned strings not written yet
+	TArray<TPair<uint32, FString>> PendingStrings;
+
+	uint32 NextStringId = 1;
+
+	/// Bumped on every start, invalidating the interned ids cached by threads
+	std::atomic<uint32> Generation{0};
+
+	std::atomic<int64> NumDropped{0};
+
+	/// Guards the file and reading of the buffers
+	FCriticalSection FileCriticalSection;
+
+	TUniquePtr<IFileHandle> File;
+
+	/// Scratch space for reading buffers
+	TArray<uint8> ReadBytes;
+
+	/// Thread id, offset and size of each buffer's content in ReadBytes
+	TArray<TTuple<uint32, int32, int32>> ReadRanges;
+
+	FWriter* Writer = nullptr;
+
+	FRunnableThread* WriterThread = nullptr;
+
+	FDelegateHandle SystemErrorHandle;
+};
+
+FState& GetState()
+{
+	static FState State;
+	return State;
+}
+
+struct FThreadState
+{
+	~FThreadState()
+	{
+		if (Buffer != nullptr)
+		{
+			Buffer->bRetired.store(true, std::memory_order_release);
+		}
+	}
+
+	FThreadBuffer* Buffer = nullptr;
+
+	uint32 Generation = 0;
+
+	TMap<const TCHAR*, uint32> FormatIds;
+
+	TMap<FName, uint32> CategoryIds;
+};
+
+thread_local FThreadState ThreadState;
+
+template <class KeyType>
+uint32 Intern(TMap<KeyType, uint32>& Ids, const KeyType& Key, const TCHAR* const String)
+{
+	FState& State = GetState();
+	FScopeLock Lock{&State.RegistryCriticalSection};
+
+	if (const uint32* const Id = Ids.Find(Key))
+	{
+		return *Id;
+	}
+
+	const uint32 Id = State.NextStringId++;
+	Ids.Add(Key, Id);
+	State.PendingStrings.Emplace(Id, String);
+	return Id;
+}
+
+FThreadState& GetThreadState()
+{
+	FState& State = GetState();
+	const uint32 Generation = State.Generation.load(std::memory_order_acquire);
+	if (ThreadState.Generation != Generation)
+	{
+		ThreadState.Generation = Generation;
+		ThreadState.FormatIds.Reset();
+		ThreadState.CategoryIds.Reset();
+	}
+
+	if (ThreadState.Buffer == nullptr)
+	{
+		FScopeLock Lock{&State.RegistryCriticalSection};
+		ThreadState.Buffer =
+			State.Buffers.Emplace_GetRef(MakeUnique<FThreadBuffer>(FPlatformTLS::GetCurrentThreadId())).Get();
+	}
+
+	return ThreadState;
+}
+
+void Write(const FName Category, const TCHAR* const Format, TArray<uint8, TInlineAllocator<256>>& Entry)
+{
+	FThreadState& Thread = GetThreadState();
+
+	uint32* CategoryId = Thread.CategoryIds.Find(Category);
+	if (CategoryId == nullptr)
+	{
+		CategoryId = &Thread.CategoryIds.Add(
+			Category, Intern(GetState().CategoryIds, Category, *Category.ToString()));
+	}
+
+	uint32* FormatId = Thread.FormatIds.Find(Format);
+	if (FormatId == nullptr)
+	{
+		FormatId = &Thread.FormatIds.Add(Format, Intern(GetState().FormatIds, Format, Format));
+	}
+
+	const uint32 Size = Entry.Num();
+	const uint64 Cycles = FPlatformTime::Cycles64();
+	FMemory::Memcpy(Entry.GetData(), &Size, sizeof(Size));
+	FMemory::Memcpy(Entry.GetData() + 4, &Cycles, sizeof(Cycles));
+	FMemory::Memcpy(Entry.GetData() + 12, CategoryId, sizeof(uint32));
+	FMemory::Memcpy(Entry.GetData() + 17, FormatId, sizeof(uint32));
+
+	if (!Thread.Buffer->TryWrite(Entry.GetData(), Size))
+	{
+		GetState().NumDropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+template <class T>
+void WriteRaw(IFileHandle& File, const T& Value)
+{
+	File.Write(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+}
+
+/// Frees the buffers of exited threads, which were read already. Requires the file and registry locks.
+void FreeRetiredBuffersLocked(FState& State, TConstArrayView<FThreadBuffer*> RetiredBuffers)
+{
+	State.Buffers.RemoveAllSwap([RetiredBuffers](const TUniquePtr<FThreadBuffer>& Buffer)
+								{ return RetiredBuffers.Contains(Buffer.Get()); });
+}
+
+/// Writes pending strings and the content of all buffers. Requires the file lock.
+void DrainLocked(FState& State)
+{
+	ZKZ_RETURN_IF(!State.File.IsValid());
+
+	TArray<FThreadBuffer*, TInlineAllocator<64>> Buffers;
+	{
+		FScopeLock Lock{&State.RegistryCriticalSection};
+		for (const TUniquePtr<FThreadBuffer>& Buffer : State.Buffers)
+		{
+			Buffers.Emplace(Buffer.Get());
+		}
+	}
+
+	// Buffers are read before taking the strings: entries are written after interning their strings, so every entry
+	// read has its strings pending by then, while strings taken first could miss those of entries written since
+	State.ReadBytes.Reset();
+	State.ReadRanges.Reset();
+	TArray<FThreadBuffer*, TInlineAllocator<16>> RetiredBuffers;
+	for (FThreadBuffer* const Buffer : Buffers)
+	{
+		// Checked before reading, so that nothing is written to a retired buffer after its last read
+		if (Buffer->bRetired.load(std::memory_order_acquire))
+		{
+			RetiredBuffers.Emplace(Buffer);
+		}
+
+		const int32 Offset = State.ReadBytes.Num();
+		Buffer->Read(State.ReadBytes);
+		if (State.ReadBytes.Num() > Offset)
+		{
+			State.ReadRanges.Emplace(Buffer->ThreadId, Offset, State.ReadBytes.Num() - Offset);
+		}
+	}
+
+	TArray<TPair<uint32, FString>> Strings;
+	{
+		FScopeLock Lock{&State.RegistryCriticalSection};
+		Strings = MoveTemp(State.PendingStrings);
+		FreeRetiredBuffersLocked(State, RetiredBuffers);
+	}
+
+	IFileHandle& File = *State.File;
+
+	// Strings first, so that they precede the entries referencing them
+	for (const TPair<uint32, FString>& String : Strings)
+	{
+		WriteRaw(File, ERecordType::String);
+		WriteRaw(File, String.Key);
+		WriteRaw(File, static_cast<uint32>(String.Value.Len()));
+		File.Write(reinterpret_cast<const uint8*>(*String.Value), String.Value.Len() * sizeof(TCHAR));
+	}
+
+	for (const TTuple<uint32, int32, int32>& Range : State.ReadRanges)
+	{
+		WriteRaw(File, ERecordType::Entries);
+		WriteRaw(File, Range.Get<0>());
+		WriteRaw(File, static_cast<uint32>(Range.Get<2>()));
+		File.Write(State.ReadBytes.GetData() + Range.Get<1>(), Range.Get<2>());
+	}
+
+	File.Flush();
+}
+
+void Drain()
+{
+	FState& State = GetState();
+	FScopeLock Lock{&State.FileCriticalSection};
+	DrainLocked(State);
+}
+
+/// Writes as much as possible when the process is going down. The file lock may be held by a thread which will never
+/// release it (e.g. the one that crashed), so it only waits for a bit.
+void DrainOnSystemError()
+{
+	FState& State = GetState();
+	for (int32 Attempt = 0; Attempt < 100; ++Attempt)
+	{
+		if (State.FileCriticalSection.TryLock())
+		{
+			DrainLocked(State);
+			State.FileCriticalSection.Unlock();
+			return;
+		}
+
+		FPlatformProcess::SleepNoStats(0.001f);
+	}
+}
+
+class FWriter final : public FRunnable
+{
+public:
+	FWriter() : WakeEvent{FPlatformProcess::GetSynchEventFromPool()}
+	{
+	}
+
+	virtual ~FWriter() override
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	}
+
+	virtual uint32 Run() override
+	{
+		while (!bStopRequested.load(std::memory_order_relaxed))
+		{
+			WakeEvent->Wait(FTimespan::FromMilliseconds(10.0));
+			Drain();
+		}
+
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopRequested.store(true, std::memory_order_relaxed);
+		WakeEvent->Trigger();
+	}
+
+private:
+	FEvent* WakeEvent;
+
+	std::atomic<bool> bStopRequested{false};
+};
+
+// -- Decoding
+
+struct FReader
+{
+	TConstArrayView<uint8> Data;
+
+	int32 Offset = 0;
+
+	template <class T>
+	bool Read(T& OutValue)
+	{
+		ZKZ_RETURN_IF(Offset + static_cast<int32>(sizeof(T)) > Data.Num(), false);
+
+		FMemory::Memcpy(&OutValue, Data.GetData() + Offset, sizeof(T));
+		Offset += sizeof(T);
+		return true;
+	}
+
+	template <class CharType>
+	bool ReadString(FString& OutString)
+	{
+		uint32 NumChars = 0;
+		ZKZ_RETURN_IF(!Read(NumChars), false);
+		ZKZ_RETURN_IF(Offset + static_cast<int64>(NumChars) * sizeof(CharType) > Data.Num(), false);
+
+		OutString = FString::ConstructFromPtrSize(reinterpret_cast<const CharType*>(Data.GetData() + Offset), NumChars);
+		Offset += NumChars * sizeof(CharType);
+		return true;
+	}
+};
+
+struct FArg
+{
+	EArgType Type = EArgType::Int64;
+
+	uint64 Bits = 0;
+
+	FString String;
+
+	int64 AsInt64() const
+	{
+		return Type == EArgType::Double ? static_cast<int64>(AsDouble()) : static_cast<int64>(Bits);
+	}
+
+	double AsDouble() const
+	{
+		switch (Type)
+		{
+		case EArgType::Double:
+			return std::bit_cast<double>(Bits);
+		case EArgType::Int64:
+			return static_cast<double>(static_cast<int64>(Bits));
+		default:
+			return static_cast<double>(Bits);
+		}
+	}
+};
+
+bool ReadArg(FReader& Reader, FArg& OutArg)
+{
+	ZKZ_RETURN_IF(!Reader.Read(OutArg.Type), false);
+
+	switch (OutArg.Type)
+	{
+	case EArgType::Int64:
+	case EArgType::UInt64:
+	case EArgType::Double:
+	case EArgType::Pointer:
+		return Reader.Read(OutArg.Bits);
+	case EArgType::String:
+		return Reader.ReadString<TCHAR>(OutArg.String);
+	case EArgType::AnsiString:
+		return Reader.ReadString<ANSICHAR>(OutArg.String);
+	}
+
+	return false;
+}
+
+int32 FormatSpec(TCHAR* const Dest, const SIZE_T DestSize, const TCHAR* Spec, ...)
+{
+	va_list Args;
+	va_start(Args, Spec);
+	const int32 Result = FCString::GetVarArgs(Dest, DestSize, Spec, Args);
+	va_end(Args);
+	return Result;
+}
+
+/// printf-style formatting with the recorded args. Each conversion is formatted on its own, with the length modifier
+/// replaced to match how the arg was recorded.
+FString FormatMessage(const FString& Format, TConstArrayView<FArg> Args)
+{
+	TStringBuilder<512> Message;
+	int32 ArgIdx = 0;
+	auto NextArg = [&]() -> const FArg* { return Args.IsValidIndex(ArgIdx) ? &Args[ArgIdx++] : nullptr; };
+
+	const TCHAR* Char = *Format;
+	while (*Char != TEXT('\0'))
+	{
+		if (*Char != TEXT('%'))
+		{
+			Message << *Char++;
+			continue;
+		}
+
+		if (Char[1] == TEXT('%'))
+		{
+			Message << TEXT('%');
+			Char += 2;
+			continue;
+		}
+
+		// Flags, width and precision are kept, '*' is replaced by the value of its arg
+		TStringBuilder<32> Spec;
+		Spec << *Char++;
+		while (*Char != TEXT('\0') && FCString::Strchr(TEXT("-+ #0123456789.*"), *Char) != nullptr)
+		{
+			if (*Char == TEXT('*'))
+			{
+				const FArg* const WidthArg = NextArg();
+				Spec << (WidthArg != nullptr ? WidthArg->AsInt64() : 0);
+			}
+			else
+			{
+				Spec << *Char;
+			}
+
+			++Char;
+		}
+
+		// Length modifiers are dropped, the recorded arg type decides
+		while (*Char != TEXT('\0') && FCString::Strchr(TEXT("hlLqjztI0123456789"), *Char) != nullptr)
+		{
+			++Char;
+		}
+
+		const TCHAR Conversion = *Char;
+		if (Conversion == TEXT('\0'))
+		{
+			break;
+		}
+
+		++Char;
+
+		const FArg* const Arg = NextArg();
+		if (Arg == nullptr)
+		{
+			Message << TEXT("<missing>");
+			continue;
+		}
+
+		TCHAR Formatted[512];
+		switch (Conversion)
+		{
+		case TEXT('d'):
+		case TEXT('i'):
+			Spec << TEXT("lld");
+			FormatSpec(Formatted, UE_ARRAY_COUNT(Formatted), Spec.ToString(), Arg->AsInt64());
+			break;
+		case TEXT('u'):
+		case TEXT('x'):
+		case TEXT('X'):
+		case TEXT('o'):
+			Spec << TEXT("ll") << Conversion;
+			FormatSpec(Formatted, UE_ARRAY_COUNT(Formatted), Spec.ToString(), static_cast<uint64>(Arg->AsInt64()));
+			break;
+		case TEXT('c'):
+			Spec << Conversion;
+			FormatSpec(Formatted, UE_ARRAY_COUNT(Formatted), Spec.ToString(), static_cast<int32>(Arg->AsInt64()));
+			break;
+		case TEXT('f'):
+		case TEXT('F'):
+		case TEXT('e'):
+		case TEXT('E'):
+		case TEXT('g'):
+		case TEXT('G'):
+		case TEXT('a'):
+		case TEXT('A'):
+			Spec << Conversion;
+			FormatSpec(Formatted, UE_ARRAY_COUNT(Formatted), Spec.ToString(), Arg->AsDouble());
+			break;
+		case TEXT('p'):
+			Spec << TEXT('p');
+			FormatSpec(
+				Formatted, UE_ARRAY_COUNT(Formatted), Spec.ToString(), reinterpret_cast<void*>(UPTRINT(Arg->Bits)));
+			break;
+		case TEXT('s'):
+		case TEXT('S'):
+			if (Spec.Len() == 1)
+			{
+				// Plain %s, appended directly so that long strings aren't truncated
+				Message << Arg->String;
+				continue;
+			}
+
+			Spec << TEXT('s');
+			FormatSpec(Formatted, UE_ARRAY_COUNT(Formatted), Spec.ToString(), *Arg->String);
+			break;
+		default:
+			Message << TEXT("<unsupported %") << Conversion << TEXT('>');
+			continue;
+		}
+
+		Message << Formatted;
+	}
+
+	return FString{Message.ToView()};
+}
+
+/// Decodes the entries of a single Entries record
+void DecodeEntries(
+	const FFileHeader& Header,
+	const TMap<uint32, FString>& Strings,
+	const uint32 ThreadId,
+	FReader Reader,
+	TStringBuilder<4096>& OutText)
+{
+	static const FString UnknownString = TEXT("<unknown>");
+
+	TArray<FArg, TInlineAllocator<8>> Args;
+	while (Reader.Offset < Reader.Data.Num())
+	{
+		const int32 EntryStart = Reader.Offset;
+		uint32 Size = 0;
+		uint64 Cycles = 0;
+		uint32 CategoryId = 0;
+		uint8 Verbosity = 0;
+		uint32 FormatId = 0;
+		uint8 NumArgs = 0;
+		if (!Reader.Read(Size) || !Reader.Read(Cycles) || !Reader.Read(CategoryId) || !Reader.Read(Verbosity)
+			|| !Reader.Read(FormatId) || !Reader.Read(NumArgs))
+		{
+			return;
+		}
+
+		// Size comes from the file, a corrupt one would move the offset out of the data or backwards
+		if (Size < static_cast<uint32>(EntryHeaderSize) || Size > static_cast<uint32>(Reader.Data.Num() - EntryStart))
+		{
+			return;
+		}
+
+		Args.Reset();
+		for (int32 ArgIdx = 0; ArgIdx < NumArgs; ++ArgIdx)
+		{
+			if (!ReadArg(Reader, Args.AddDefaulted_GetRef()))
+			{
+				Args.Pop();
+				break;
+			}
+		}
+
+		const double Seconds = static_cast<double>(Cycles - Header.StartCycles) * Header.SecondsPerCycle;
+		const FDateTime Time = FDateTime{Header.StartUtcTicks} + FTimespan::FromSeconds(Seconds);
+
+		const FString* const Category = Strings.Find(CategoryId);
+		const FString* const Format = Strings.Find(FormatId);
+		OutText.Appendf(
+			TEXT("[%s][%5u]%s: %s: "),
+			*Time.ToString(TEXT("%Y.%m.%d-%H.%M.%S:%s")),
+			ThreadId,
+			Category != nullptr ? **Category : *UnknownString,
+			::ToString(static_cast<ELogVerbosity::Type>(Verbosity & ELogVerbosity::VerbosityMask)));
+		OutText << FormatMessage(Format != nullptr ? *Format : UnknownString, Args) << TEXT('\n');
+
+		// Size decides, so that entries with unknown arg types are skipped whole
+		Reader.Offset = EntryStart + Size;
+	}
+}
+
+// -- Console commands
+
+void StartFromArgs(const TArray<FString>& Args)
+{
+	Start(Args.IsEmpty() ? FString{} : Args[0]);
+}
+
+FAutoConsoleCommand StartCommand{
+	TEXT("Zkz.Log.Binary.Start"),
+	TEXT("Starts recording logs to a binary file. Optional argument: file path, Saved/Logs/<Project>.zkzlog by "
+		 "default."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&StartFromArgs)};
+
+FAutoConsoleCommand StopCommand{
+	TEXT("Zkz.Log.Binary.Stop"),
+	TEXT("Stops recording logs to a binary file."),
+	FConsoleCommandDelegate::CreateStatic(&Stop)};
+
+FAutoConsoleCommand FlushCommand{
+	TEXT("Zkz.Log.Binary.Flush"),
+	TEXT("Writes logs recorded so far to the binary file."),
+	FConsoleCommandDelegate::CreateStatic(&Flush)};
+
+}  // namespace Zkz::BinaryLog::Private
+
+namespace Zkz::BinaryLog
+{
+
+bool Start(const FString& FilePath)
+{
+	using namespace Private;
+
+	Stop();
+
+	const FString ActualFilePath = FilePath.IsEmpty()
+		? FPaths::Combine(FPaths::ProjectLogDir(), FString{FApp::GetProjectName()} + TEXT(".zkzlog"))
+		: FilePath;
+
+	IFileHandle* const File = FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*ActualFilePath);
+	ZKZ_RETURN_IF_ENSUREMSGF(File == nullptr, "Failed to open binary log file", false);
+
+	FState& State = GetState();
+	{
+		FScopeLock FileLock{&State.FileCriticalSection};
+		State.File.Reset(File);
+
+		FFileHeader Header;
+		FMemory::Memcpy(Header.Magic, FileMagic, sizeof(FileMagic));
+		Header.Version = FileVersion;
+		Header.CharSize = sizeof(TCHAR);
+		Header.SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+		Header.StartCycles = FPlatformTime::Cycles64();
+		Header.StartUtcTicks = FDateTime::UtcNow().GetTicks();
+		WriteRaw(*State.File, Header);
+
+		FScopeLock RegistryLock{&State.RegistryCriticalSection};
+		State.FormatIds.Reset();
+		State.CategoryIds.Reset();
+		State.PendingStrings.Reset();
+		State.NextStringId = 1;
+		State.Generation.fetch_add(1, std::memory_order_release);
+		State.NumDropped.store(0, std::memory_order_relaxed);
+
+		// Leftovers of the previous recording reference its string ids
+		TArray<FThreadBuffer*, TInlineAllocator<16>> RetiredBuffers;
+		for (const TUniquePtr<FThreadBuffer>& Buffer : State.Buffers)
+		{
+			if (Buffer->bRetired.load(std::memory_order_acquire))
+			{
+				RetiredBuffers.Emplace(Buffer.Get());
+			}
+
+			Buffer->Discard();
+		}
+
+		FreeRetiredBuffersLocked(State, RetiredBuffers);
+	}
+
+	State.Writer = new FWriter{};
+	State.WriterThread = FRunnableThread::Create(State.Writer, TEXT("ZkzBinaryLogWriter"), 0, TPri_BelowNormal);
+	State.SystemErrorHandle = FCoreDelegates::OnHandleSystemError.AddStatic(&DrainOnSystemError);
+
+	bRecording.store(true, std::memory_order_release);
+	return true;
+}
+
+void Stop()
+{
+	using namespace Private;
+
+	FState& State = GetState();
+	bRecording.store(false, std::memory_order_release);
+
+	if (State.WriterThread != nullptr)
+	{
+		FCoreDelegates::OnHandleSystemError.Remove(State.SystemErrorHandle);
+
+		State.WriterThread->Kill(true);
+		delete State.WriterThread;
+		State.WriterThread = nullptr;
+
+		delete State.Writer;
+		State.Writer = nullptr;
+	}
+
+	FScopeLock FileLock{&State.FileCriticalSection};
+	DrainLocked(State);
+	State.File.Reset();
+}
+
+void Flush()
+{
+	Private::Drain();
+}
+
+int64 GetNumDropped()
+{
+	return Private::GetState().NumDropped.load(std::memory_order_relaxed);
+}
+
+bool Decode(const TConstArrayView<uint8> Data, FString& OutText)
+{
+	using namespace Private;
+
+	FReader Reader{Data};
+
+	FFileHeader Header;
+	ZKZ_RETURN_IF(!Reader.Read(Header), false);
+	ZKZ_RETURN_IF(FMemory::Memcmp(Header.Magic, FileMagic, sizeof(FileMagic)) != 0, false);
+	ZKZ_RETURN_IF(Header.Version != FileVersion || Header.CharSize != sizeof(TCHAR), false);
+
+	TMap<uint32, FString> Strings;
+	TStringBuilder<4096> Text;
+
+	ERecordType RecordType;
+	while (Reader.Read(RecordType))
+	{
+		if (RecordType == ERecordType::String)
+		{
+			uint32 Id = 0;
+			FString String;
+			if (!Reader.Read(Id) || !Reader.ReadString<TCHAR>(String))
+			{
+				break;
+			}
+
+			Strings.Add(Id, MoveTemp(String));
+		}
+		else if (RecordType == ERecordType::Entries)
+		{
+			uint32 ThreadId = 0;
+			uint32 NumBytes = 0;
+			if (!Reader.Read(ThreadId) || !Reader.Read(NumBytes))
+			{
+				break;
+			}
+
+			// Truncated record is decoded as far as it goes
+			const int32 NumAvailable = FMath::Min<int64>(NumBytes, Data.Num() - Reader.Offset);
+			DecodeEntries(Header, Strings, ThreadId, FReader{Data.Slice(Reader.Offset, NumAvailable)}, Text);
+			Reader.Offset += NumAvailable;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	OutText = Text.ToString();
+	return true;
+}
+
+}  // namespace Zkz::BinaryLog
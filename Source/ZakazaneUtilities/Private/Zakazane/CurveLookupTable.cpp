@@ -0,0 +1,118 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#include "Zakazane/CurveLookupTable.h"
+
+#include "Curves/CurveFloat.h"
+#include "UObject/ObjectKey.h"
+#include "Zakazane/ReturnIfMacros.h"
+
+namespace Zkz::CurveLookupTablePrivate
+{
+
+FCriticalSection SharedTablesCriticalSection;
+
+/// Weak, so that tables of curves no longer interpolated with are freed
+TMap<TObjectKey<UCurveFloat>, TWeakPtr<const FCurveLookupTable>> SharedTables;
+
+}  // namespace Zkz::CurveLookupTablePrivate
+
+namespace Zkz
+{
+
+FCurveLookupTable::FCurveLookupTable(const FRichCurve& Curve, const int32 NumSamples) : CurveHash{HashCurve(Curve)}
+{
+	if (Curve.GetNumKeys() == 0)
+	{
+		Samples.Init(Curve.GetDefaultValue(), 1);
+		return;
+	}
+
+	Curve.GetTimeRange(MinTime, MaxTime);
+
+	// Single key curves are constant, one sample is enough
+	const int32 ActualNumSamples = MaxTime > MinTime ? FMath::Max(2, NumSamples) : 1;
+	Samples.SetNumUninitialized(ActualNumSamples);
+	for (int32 SampleIdx = 0; SampleIdx < ActualNumSamples; ++SampleIdx)
+	{
+		const float Alpha = ActualNumSamples > 1 ? static_cast<float>(SampleIdx) / (ActualNumSamples - 1) : 0.0f;
+		Samples[SampleIdx] = Curve.Eval(FMath::Lerp(MinTime, MaxTime, Alpha));
+	}
+}
+
+TSharedRef<const FCurveLookupTable> FCurveLookupTable::GetShared(const UCurveFloat& Curve)
+{
+	using namespace CurveLookupTablePrivate;
+
+	FScopeLock Lock{&SharedTablesCriticalSection};
+
+	TWeakPtr<const FCurveLookupTable>& SharedTable = SharedTables.FindOrAdd(&Curve);
+	const TSharedPtr<const FCurveLookupTable> CachedTable = SharedTable.Pin();
+	bool bCached = CachedTable.IsValid();
+#if WITH_EDITOR
+	// Tables of edited curves are stale, those still referenced stay alive until their users get a new one. Curves
+	// aren't edited outside the editor, so it's only checked here.
+	bCached = bCached && CachedTable->IsBakedFrom(Curve.FloatCurve);
+#endif
+
+	if (bCached)
+	{
+		return CachedTable.ToSharedRef();
+	}
+
+	// A new table is baked only every so often, a good time to drop the entries of the freed ones
+	for (auto It = SharedTables.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.IsValid() && It->Key != TObjectKey<UCurveFloat>{&Curve})
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	const TSharedRef<const FCurveLookupTable> Table = MakeShared<const FCurveLookupTable>(Curve.FloatCurve);
+	SharedTables.FindChecked(&Curve) = Table;
+	return Table;
+}
+
+uint32 FCurveLookupTable::HashCurve(const FRichCurve& Curve)
+{
+	uint32 Hash = GetTypeHash(Curve.GetDefaultValue());
+	for (const FRichCurveKey& Key : Curve.GetConstRefOfKeys())
+	{
+		const uint32 Modes = static_cast<uint32>(Key.InterpMode.GetValue())
+			| static_cast<uint32>(Key.TangentMode.GetValue()) << 8
+			| static_cast<uint32>(Key.TangentWeightMode.GetValue()) << 16;
+		Hash = HashCombineFast(Hash, Modes);
+
+		for (const float KeyValue : {Key.Time, Key.Value, Key.ArriveTangent, Key.LeaveTangent})
+		{
+			Hash = HashCombineFast(Hash, GetTypeHash(KeyValue));
+		}
+
+		Hash = HashCombineFast(Hash, GetTypeHash(Key.ArriveTangentWeight));
+		Hash = HashCombineFast(Hash, GetTypeHash(Key.LeaveTangentWeight));
+	}
+
+	return Hash;
+}
+
+bool FCurveLookupTable::IsBakedFrom(const FRichCurve& Curve) const
+{
+	return CurveHash == HashCurve(Curve);
+}
+
+float FCurveLookupTable::Evaluate(const float Time) const
+{
+	ZKZ_RETURN_IF(MaxTime <= MinTime, Samples.IsEmpty() ? 0.0f : Samples[0]);
+	return EvaluateNormalized((Time - MinTime) / (MaxTime - MinTime));
+}
+
+float FCurveLookupTable::EvaluateNormalized(const float Alpha) const
+{
+	ZKZ_RETURN_IF(Samples.Num() < 2, Samples.IsEmpty() ? 0.0f : Samples[0]);
+
+	const float SamplePosition = FMath::Clamp(Alpha, 0.0f, 1.0f) * (Samples.Num() - 1);
+	const int32 SampleIdx = FMath::Min(FMath::FloorToInt32(SamplePosition), Samples.Num() - 2);
+	return FMath::Lerp(Samples[SampleIdx], Samples[SampleIdx + 1], SamplePosition - SampleIdx);
+}
+
+}  // namespace Zkz
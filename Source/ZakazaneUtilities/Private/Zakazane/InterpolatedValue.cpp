@@ -1,7 +1,48 @@
 #include "Zakazane/InterpolatedValue.h"
 
+#include "Curves/CurveFloat.h"
+#include "Zakazane/Interpolation.h"
 #include "Zakazane/ReturnIfMacros.h"
 
+namespace Zkz::InterpolatedValuePrivate
+{
+
+template <class T>
+void Update(
+	T& Current,
+	const T& Target,
+	bool& bSettled,
+	const float InterpSpeed,
+	const float DeltaTime,
+	const FSimpleMulticastDelegate& OnArrived)
+{
+	ZKZ_RETURN_IF(bSettled);
+
+	// Non-positive speed snaps to target
+	bSettled = Interpolation::TExponentialPolicy<T>{InterpSpeed}.Advance(Current, Target, DeltaTime);
+	if (bSettled)
+	{
+		OnArrived.Broadcast();
+	}
+}
+
+template <class T>
+T PredictValue(const T& Current, const T& Target, const bool bSettled, const float InterpSpeed, const float Time)
+{
+	ZKZ_RETURN_IF(bSettled, Target);
+	return Interpolation::TExponentialPolicy<T>{InterpSpeed}.Evaluate(Current, Target, Time);
+}
+
+template <class T>
+float GetTimeToTarget(
+	const T& Current, const T& Target, const bool bSettled, const float InterpSpeed, const float Tolerance)
+{
+	ZKZ_RETURN_IF(bSettled, 0.0f);
+	return Interpolation::TExponentialPolicy<T>{InterpSpeed}.GetTimeToTarget(Current, Target, Tolerance);
+}
+
+}  // namespace Zkz::InterpolatedValuePrivate
+
 FZkzInterpolatedFloatValue::FZkzInterpolatedFloatValue(
 	const float InValue, const bool bInEnableInterpolation, const float InInterpSpeed)
 	: bEnableInterpolation{bInEnableInterpolation}, InterpSpeed{InInterpSpeed}, Current{InValue}, Target{InValue}
@@ -17,16 +58,13 @@ void FZkzInterpolatedFloatValue::Reset(const float InValue)
 {
 	Target = InValue;
 	Current = InValue;
+	bSettled = true;
 }
 
 void FZkzInterpolatedFloatValue::Update(const float DeltaTime)
 {
-	if (!bEnableInterpolation)
-	{
-		Current = Target;
-	}
-
-	Current = FMath::FInterpTo(Current, Target, DeltaTime, InterpSpeed);
+	Zkz::InterpolatedValuePrivate::Update(
+		Current, Target, bSettled, bEnableInterpolation ? InterpSpeed : 0.0f, DeltaTime, OnArrived);
 }
 
 float FZkzInterpolatedFloatValue::GetCurrent() const
@@ -42,6 +80,7 @@ float FZkzInterpolatedFloatValue::GetTarget() const
 void FZkzInterpolatedFloatValue::SetTarget(const float InTarget)
 {
 	Target = InTarget;
+	bSettled = false;
 }
 
 void FZkzInterpolatedFloatValue::SetEnableInterpolation(const bool InEnable)
@@ -56,6 +95,23 @@ void FZkzInterpolatedFloatValue::SetInterpSpeed(const float InInterpSpeed)
 	InterpSpeed = InInterpSpeed;
 }
 
+bool FZkzInterpolatedFloatValue::IsSettled() const
+{
+	return bSettled;
+}
+
+float FZkzInterpolatedFloatValue::PredictValue(const float Time) const
+{
+	return Zkz::InterpolatedValuePrivate::PredictValue(
+		Current, Target, bSettled, bEnableInterpolation ? InterpSpeed : 0.0f, Time);
+}
+
+float FZkzInterpolatedFloatValue::GetTimeToTarget(const float Tolerance) const
+{
+	return Zkz::InterpolatedValuePrivate::GetTimeToTarget(
+		Current, Target, bSettled, bEnableInterpolation ? InterpSpeed : 0.0f, Tolerance);
+}
+
 FZkzInterpolatedVectorValue::FZkzInterpolatedVectorValue(
 	const FVector& InValue, const bool bInEnableInterpolation, const float InInterpSpeed)
 	: bEnableInterpolation{bInEnableInterpolation}, InterpSpeed{InInterpSpeed}, Current{InValue}, Target{InValue}
@@ -70,16 +126,13 @@ void FZkzInterpolatedVectorValue::Reset(const FVector& InValue)
 {
 	Target = InValue;
 	Current = InValue;
+	bSettled = true;
 }
 
 void FZkzInterpolatedVectorValue::Update(const float DeltaTime)
 {
-	if (!bEnableInterpolation)
-	{
-		Current = Target;
-	}
-
-	Current = FMath::VInterpTo(Current, Target, DeltaTime, InterpSpeed);
+	Zkz::InterpolatedValuePrivate::Update(
+		Current, Target, bSettled, bEnableInterpolation ? InterpSpeed : 0.0f, DeltaTime, OnArrived);
 }
 
 const FVector& FZkzInterpolatedVectorValue::GetCurrent() const
@@ -95,6 +148,7 @@ const FVector& FZkzInterpolatedVectorValue::GetTarget() const
 void FZkzInterpolatedVectorValue::SetTarget(const FVector& InTarget)
 {
 	Target = InTarget;
+	bSettled = false;
 }
 
 void FZkzInterpolatedVectorValue::SetEnableInterpolation(const bool InEnable)
@@ -109,6 +163,23 @@ void FZkzInterpolatedVectorValue::SetInterpSpeed(const float InInterpSpeed)
 	InterpSpeed = InInterpSpeed;
 }
 
+bool FZkzInterpolatedVectorValue::IsSettled() const
+{
+	return bSettled;
+}
+
+FVector FZkzInterpolatedVectorValue::PredictValue(const float Time) const
+{
+	return Zkz::InterpolatedValuePrivate::PredictValue(
+		Current, Target, bSettled, bEnableInterpolation ? InterpSpeed : 0.0f, Time);
+}
+
+float FZkzInterpolatedVectorValue::GetTimeToTarget(const float Tolerance) const
+{
+	return Zkz::InterpolatedValuePrivate::GetTimeToTarget(
+		Current, Target, bSettled, bEnableInterpolation ? InterpSpeed : 0.0f, Tolerance);
+}
+
 FZkzInterpolatedQuatValue::FZkzInterpolatedQuatValue(
 	const FQuat& InValue, const bool bInEnableInterpolation, const float InInterpSpeed)
 	: bEnableInterpolation{bInEnableInterpolation}, InterpSpeed{InInterpSpeed}, Current{InValue}, Target{InValue}
@@ -124,16 +195,13 @@ void FZkzInterpolatedQuatValue::Reset(const FQuat& InValue)
 {
 	Target = InValue;
 	Current = InValue;
+	bSettled = true;
 }
 
 void FZkzInterpolatedQuatValue::Update(const float DeltaTime)
 {
-	if (!bEnableInterpolation)
-	{
-		Current = Target;
-	}
-
-	Current = FMath::QInterpTo(Current, Target, DeltaTime, InterpSpeed);
+	Zkz::InterpolatedValuePrivate::Update(
+		Current, Target, bSettled, bEnableInterpolation ? InterpSpeed : 0.0f, DeltaTime, OnArrived);
 }
 
 const FQuat& FZkzInterpolatedQuatValue::GetCurrent() const
@@ -149,6 +217,7 @@ const FQuat& FZkzInterpolatedQuatValue::GetTarget() const
 void FZkzInterpolatedQuatValue::SetTarget(const FQuat& InTarget)
 {
 	Target = InTarget;
+	bSettled = false;
 }
 
 void FZkzInterpolatedQuatValue::SetEnableInterpolation(const bool InEnable)
@@ -163,6 +232,100 @@ void FZkzInterpolatedQuatValue::SetInterpSpeed(const float InInterpSpeed)
 	InterpSpeed = InInterpSpeed;
 }
 
+bool FZkzInterpolatedQuatValue::IsSettled() const
+{
+	return bSettled;
+}
+
+FQuat FZkzInterpolatedQuatValue::PredictValue(const float Time) const
+{
+	return Zkz::InterpolatedValuePrivate::PredictValue(
+		Current, Target, bSettled, bEnableInterpolation ? InterpSpeed : 0.0f, Time);
+}
+
+float FZkzInterpolatedQuatValue::GetTimeToTarget(const float Tolerance) const
+{
+	return Zkz::InterpolatedValuePrivate::GetTimeToTarget(
+		Current, Target, bSettled, bEnableInterpolation ? InterpSpeed : 0.0f, Tolerance);
+}
+
+FZkzCurveInterpolatedFloatValue::FZkzCurveInterpolatedFloatValue(
+	UCurveFloat* InCurve, const float InDuration, const float InValue)
+	: Curve{InCurve}, Duration{InDuration}, Current{InValue}, Target{InValue}
+{
+}
+
+void FZkzCurveInterpolatedFloatValue::Reset(const float InValue)
+{
+	Target = InValue;
+	Current = InValue;
+	bSettled = true;
+}
+
+void FZkzCurveInterpolatedFloatValue::Update(const float DeltaTime)
+{
+	ZKZ_RETURN_IF(bSettled);
+
+	Elapsed += DeltaTime;
+	if (Elapsed >= MotionDuration)
+	{
+		Current = Target;
+		bSettled = true;
+		OnArrived.Broadcast();
+		return;
+	}
+
+	const float Alpha = Elapsed / MotionDuration;
+	Current = FMath::Lerp(Start, Target, LookupTable.IsValid() ? LookupTable->EvaluateNormalized(Alpha) : Alpha);
+}
+
+float FZkzCurveInterpolatedFloatValue::GetCurrent() const
+{
+	return Current;
+}
+
+float FZkzCurveInterpolatedFloatValue::GetTarget() const
+{
+	return Target;
+}
+
+void FZkzCurveInterpolatedFloatValue::SetTarget(const float InTarget)
+{
+	Start = Current;
+	Target = InTarget;
+	Elapsed = 0.0f;
+	MotionDuration = Duration;
+	bSettled = false;
+
+	// Baked here rather than on load, as the curve asset may not be loaded yet when the owner is
+	bool bStale = Curve != BakedCurve;
+#if WITH_EDITOR
+	// Rebaked when the curve was edited since, which only happens in the editor
+	bStale |= LookupTable.IsValid() && !LookupTable->IsBakedFrom(Curve->FloatCurve);
+#endif
+
+	if (bStale)
+	{
+		LookupTable = Curve != nullptr ? Zkz::FCurveLookupTable::GetShared(*Curve).ToSharedPtr() : nullptr;
+		BakedCurve = Curve;
+	}
+}
+
+void FZkzCurveInterpolatedFloatValue::SetCurve(UCurveFloat* InCurve)
+{
+	Curve = InCurve;
+}
+
+void FZkzCurveInterpolatedFloatValue::SetDuration(const float InDuration)
+{
+	Duration = InDuration;
+}
+
+bool FZkzCurveInterpolatedFloatValue::IsSettled() const
+{
+	return bSettled;
+}
+
 void UZkzInterpolatedValueBlueprintFunctionLibrary::ResetFloat(
 	FZkzInterpolatedFloatValue& InterpolatedFloat, const float Value)
 {
@@ -216,3 +379,21 @@ void UZkzInterpolatedValueBlueprintFunctionLibrary::SetTargetQuat(
 {
 	InterpolatedQuat.SetTarget(Target);
 }
+
+void UZkzInterpolatedValueBlueprintFunctionLibrary::ResetCurveFloat(
+	FZkzCurveInterpolatedFloatValue& InterpolatedFloat, const float Value)
+{
+	InterpolatedFloat.Reset(Value);
+}
+
+void UZkzInterpolatedValueBlueprintFunctionLibrary::UpdateCurveFloat(
+	FZkzCurveInterpolatedFloatValue& InterpolatedFloat, const float DeltaTime)
+{
+	InterpolatedFloat.Update(DeltaTime);
+}
+
+void UZkzInterpolatedValueBlueprintFunctionLibrary::SetTargetCurveFloat(
+	FZkzCurveInterpolatedFloatValue& InterpolatedFloat, const float Target)
+{
+	InterpolatedFloat.SetTarget(Target);
+}
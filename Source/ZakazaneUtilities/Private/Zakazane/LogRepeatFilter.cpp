@@ -0,0 +1,81 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#include "Zakazane/LogRepeatFilter.h"
+
+namespace Zkz
+{
+
+bool FLogRepeatFilter::Filter(
+	const uint32 Key, const double Time, const double Window, const TFunctionRef<FEmitSummary()> MakeEmitSummary)
+{
+	if (Window <= 0.0)
+	{
+		return true;
+	}
+
+	TArray<FWindow> EndedWindows;
+	{
+		FScopeLock Lock{&CriticalSection};
+
+		FWindow& MessageWindow = Windows.FindOrAdd(Key);
+		if (Time < MessageWindow.EndTime)
+		{
+			++MessageWindow.NumRepeats;
+			return false;
+		}
+
+		// Window ended but wasn't ticked yet
+		if (MessageWindow.EmitSummary)
+		{
+			EndedWindows.Emplace(MoveTemp(MessageWindow));
+		}
+
+		MessageWindow = FWindow{Time + Window, 0, MakeEmitSummary()};
+	}
+
+	EmitSummaries(EndedWindows);
+	return true;
+}
+
+void FLogRepeatFilter::Tick(const double Time)
+{
+	TArray<FWindow> EndedWindows;
+	{
+		FScopeLock Lock{&CriticalSection};
+		for (auto It = Windows.CreateIterator(); It; ++It)
+		{
+			if (Time >= It->Value.EndTime)
+			{
+				EndedWindows.Emplace(MoveTemp(It->Value));
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	EmitSummaries(EndedWindows);
+}
+
+void FLogRepeatFilter::Reset()
+{
+	FScopeLock Lock{&CriticalSection};
+	Windows.Reset();
+}
+
+int32 FLogRepeatFilter::Num() const
+{
+	FScopeLock Lock{&CriticalSection};
+	return Windows.Num();
+}
+
+void FLogRepeatFilter::EmitSummaries(TArray<FWindow>& EndedWindows)
+{
+	for (FWindow& EndedWindow : EndedWindows)
+	{
+		if (EndedWindow.NumRepeats > 0 && EndedWindow.EmitSummary)
+		{
+			EndedWindow.EmitSummary(EndedWindow.NumRepeats);
+		}
+	}
+}
+
+}  // namespace Zkz
@@ -0,0 +1,481 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#include "Zakazane/LogStatistics.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
+#include "Zakazane/ReturnIfMacros.h"
+
+namespace Zkz
+{
+
+namespace
+{
+
+int32 MaxTrackedTemplates = 32;
+
+FAutoConsoleVariableRef CVarMaxTemplates{
+	TEXT("Zkz.Log.Stats.MaxTemplates"),
+	MaxTrackedTemplates,
+	TEXT("Number of the most frequent message templates tracked by the log statistics. Zero disables template "
+		 "tracking. Read once on startup."),
+	ECVF_ReadOnly};
+
+/// More candidates than reported templates make the counts of the top ones more accurate
+constexpr int32 TemplateCandidatesPerTemplate = 4;
+
+std::atomic<uint32> NextInstanceId{1};
+
+/// Visits the template characters of the message, returns where the template ended
+template <class VisitorType>
+const TCHAR* VisitTemplate(const TCHAR* Char, VisitorType&& Visit)
+{
+	for (int32 Len = 0; *Char != TEXT('\0') && Len < FLogStatistics::MaxTemplateLen; ++Len)
+	{
+		if (!FChar::IsDigit(*Char))
+		{
+			Visit(*Char++);
+			continue;
+		}
+
+		if (Char[0] == TEXT('0') && (Char[1] == TEXT('x') || Char[1] == TEXT('X')))
+		{
+			Char += 2;
+			while (FChar::IsHexDigit(*Char))
+			{
+				++Char;
+			}
+		}
+		else
+		{
+			while (FChar::IsDigit(*Char) || (*Char == TEXT('.') && FChar::IsDigit(Char[1])))
+			{
+				++Char;
+			}
+		}
+
+		Visit(TEXT('#'));
+	}
+
+	return Char;
+}
+
+FString EscapeCSV(const FString& Value)
+{
+	return TEXT("\"") + Value.Replace(TEXT("\""), TEXT("\"\"")) + TEXT("\"");
+}
+
+void DumpToOutput(FOutputDevice& Output)
+{
+	FLogStatistics::Get().Dump(Output);
+}
+
+void DumpCSV(const TArray<FString>& Args, FOutputDevice& Output)
+{
+	const FString FilePath = Args.IsEmpty()
+		? FPaths::Combine(
+			  FPaths::ProjectLogDir(), FString::Printf(TEXT("LogStats-%s.csv"), *FDateTime::Now().ToString()))
+		: Args[0];
+
+	if (FLogStatistics::Get().ExportCSV(FilePath))
+	{
+		Output.Logf(TEXT("Log statistics written to %s"), *FilePath);
+	}
+	else
+	{
+		Output.Logf(ELogVerbosity::Error, TEXT("Failed to write log statistics to %s"), *FilePath);
+	}
+}
+
+void ResetStats()
+{
+	FLogStatistics::Get().Reset();
+}
+
+FAutoConsoleCommandWithOutputDevice DumpCommand{
+	TEXT("Zkz.Log.Stats.Dump"),
+	TEXT("Prints the number of log messages by category and verbosity and the most frequent message templates."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&DumpToOutput)};
+
+FAutoConsoleCommand DumpCSVCommand{
+	TEXT("Zkz.Log.Stats.DumpCSV"),
+	TEXT("Writes log statistics as CSV. Optional argument: file path, Saved/Logs/LogStats-<Time>.csv by default. "
+		 "Templates are written next to it, with -Templates appended to the name."),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&DumpCSV)};
+
+FAutoConsoleCommand ResetCommand{
+	TEXT("Zkz.Log.Stats.Reset"),
+	TEXT("Clears log statistics."),
+	FConsoleCommandDelegate::CreateStatic(&ResetStats)};
+
+}  // namespace
+
+int64 FLogStatistics::FCategoryStats::GetNumMessagesWorseThan(const ELogVerbosity::Type Verbosity) const
+{
+	int64 Result = 0;
+
+	for (int32 VerbosityIdx = Verbosity & ELogVerbosity::VerbosityMask; VerbosityIdx > 0; --VerbosityIdx)
+	{
+		Result += NumMessages[VerbosityIdx];
+	}
+
+	return Result;
+}
+
+FLogStatistics& FLogStatistics::Get()
+{
+	static FLogStatistics Instance{MaxTrackedTemplates};
+	return Instance;
+}
+
+FLogStatistics::FLogStatistics(const int32 InMaxTemplates)
+	: MaxTemplates{FMath::Max(InMaxTemplates, 0)}, InstanceId{NextInstanceId.fetch_add(1, std::memory_order_relaxed)}
+{
+}
+
+void FLogStatistics::Serialize(const TCHAR* V, const ELogVerbosity::Type Verbosity, const FName& Category)
+{
+	const int32 VerbosityIdx = Verbosity & ELogVerbosity::VerbosityMask;
+
+	// Not a message, e.g. SetColor
+	ZKZ_RETURN_IF(VerbosityIdx == ELogVerbosity::NoLogging || V == nullptr);
+
+	// FNV-1a of the template
+	uint32 TemplateHash = 2166136261u;
+	const TCHAR* const TemplateEnd = MaxTemplates > 0
+		? VisitTemplate(V, [&TemplateHash](const TCHAR Char) { TemplateHash = (TemplateHash ^ Char) * 16777619u; })
+		: V;
+	const int64 NumChars = (TemplateEnd - V) + FCString::Strlen(TemplateEnd);
+
+	FCounters& Counters = FindOrAddCounters(Category);
+	Counters.NumMessages[VerbosityIdx].fetch_add(1, std::memory_order_relaxed);
+	Counters.NumChars[VerbosityIdx].fetch_add(NumChars, std::memory_order_relaxed);
+
+	if (MaxTemplates > 0)
+	{
+		AddTemplate(V, TemplateHash, static_cast<ELogVerbosity::Type>(VerbosityIdx), Category);
+	}
+}
+
+bool FLogStatistics::CanBeUsedOnMultipleThreads() const
+{
+	return true;
+}
+
+bool FLogStatistics::CanBeUsedOnAnyThread() const
+{
+	return true;
+}
+
+TArray<FLogStatistics::FCategoryStats> FLogStatistics::GetCategoryStats() const
+{
+	TArray<FCategoryStats> Result;
+	{
+		FReadScopeLock Lock{CountersLock};
+		Result.Reserve(CountersByCategory.Num());
+		for (const auto& [Category, Counters] : CountersByCategory)
+		{
+			FCategoryStats& Stats = Result.Emplace_GetRef();
+			Stats.Category = Category;
+			for (int32 VerbosityIdx = 0; VerbosityIdx < ELogVerbosity::NumVerbosity; ++VerbosityIdx)
+			{
+				Stats.NumMessages[VerbosityIdx] = Counters->NumMessages[VerbosityIdx].load(std::memory_order_relaxed);
+				Stats.NumChars[VerbosityIdx] = Counters->NumChars[VerbosityIdx].load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	Result.Sort(
+		[](const FCategoryStats& A, const FCategoryStats& B)
+		{
+			const auto Key = [](const FCategoryStats& Stats)
+			{
+				return MakeTuple(
+					Stats.GetNumMessagesWorseThan(ELogVerbosity::Error),
+					Stats.NumMessages[ELogVerbosity::Warning],
+					Stats.GetNumMessagesWorseThan(ELogVerbosity::VeryVerbose));
+			};
+			return Key(B) < Key(A);
+		});
+	return Result;
+}
+
+TArray<FLogStatistics::FTemplateStats> FLogStatistics::GetTopTemplates() const
+{
+	// Candidates of each thread, with the count of its least frequent one if they're all taken
+	struct FThreadSnapshot
+	{
+		TArray<FTemplateCandidate> Candidates;
+
+		int64 MinCount = 0;
+	};
+
+	TArray<FThreadSnapshot> Snapshots;
+	{
+		FScopeLock Lock{&TemplatesCriticalSection};
+		for (const TSharedRef<FThreadTemplates>& Thread : ThreadTemplates)
+		{
+			FScopeLock ThreadLock{&Thread->CriticalSection};
+			Snapshots.Emplace(FThreadSnapshot{Thread->Candidates});
+		}
+	}
+
+	int64 TotalMinCount = 0;
+	for (FThreadSnapshot& Snapshot : Snapshots)
+	{
+		if (!Snapshot.Candidates.IsEmpty() && Snapshot.Candidates.Num() >= MaxTemplates * TemplateCandidatesPerTemplate)
+		{
+			Snapshot.MinCount = Snapshot.Candidates[0].Stats.Count;
+			for (const FTemplateCandidate& Candidate : Snapshot.Candidates)
+			{
+				Snapshot.MinCount = FMath::Min(Snapshot.MinCount, Candidate.Stats.Count);
+			}
+		}
+
+		TotalMinCount += Snapshot.MinCount;
+	}
+
+	// A template may have been logged by a thread up to as often as the thread's least frequent candidate without
+	// being among its candidates, so every thread adds its least frequent count, replaced by the actual one if present
+	TMap<uint32, FTemplateStats> MergedStats;
+	for (const FThreadSnapshot& Snapshot : Snapshots)
+	{
+		for (const FTemplateCandidate& Candidate : Snapshot.Candidates)
+		{
+			FTemplateStats* Stats = MergedStats.Find(Candidate.Key);
+			if (Stats == nullptr)
+			{
+				Stats = &MergedStats.Add(Candidate.Key, Candidate.Stats);
+				Stats->Count = TotalMinCount;
+				Stats->MaxError = TotalMinCount;
+			}
+
+			Stats->Count += Candidate.Stats.Count - Snapshot.MinCount;
+			Stats->MaxError += Candidate.Stats.MaxError - Snapshot.MinCount;
+		}
+	}
+
+	TArray<FTemplateStats> Result;
+	MergedStats.GenerateValueArray(Result);
+	Result.Sort([](const FTemplateStats& A, const FTemplateStats& B) { return A.Count > B.Count; });
+	if (Result.Num() > MaxTemplates)
+	{
+		Result.SetNum(MaxTemplates);
+	}
+
+	return Result;
+}
+
+void FLogStatistics::Reset()
+{
+	{
+		FReadScopeLock Lock{CountersLock};
+		for (const auto& [Category, Counters] : CountersByCategory)
+		{
+			for (int32 VerbosityIdx = 0; VerbosityIdx < ELogVerbosity::NumVerbosity; ++VerbosityIdx)
+			{
+				Counters->NumMessages[VerbosityIdx].store(0, std::memory_order_relaxed);
+				Counters->NumChars[VerbosityIdx].store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	FScopeLock Lock{&TemplatesCriticalSection};
+	for (const TSharedRef<FThreadTemplates>& Thread : ThreadTemplates)
+	{
+		FScopeLock ThreadLock{&Thread->CriticalSection};
+		Thread->Candidates.Reset();
+		Thread->CandidateIndices.Reset();
+	}
+}
+
+void FLogStatistics::Dump(FOutputDevice& Output) const
+{
+	// Stats are copied first, as the output may well be the log these stats are collected from
+	const TArray<FCategoryStats> CategoryStats = GetCategoryStats();
+	const TArray<FTemplateStats> TopTemplates = GetTopTemplates();
+
+	Output.Logf(TEXT("Log messages by category (Fatal / Error / Warning / Display / Log / Verbose / VeryVerbose):"));
+	for (const FCategoryStats& Stats : CategoryStats)
+	{
+		int64 NumChars = 0;
+		for (const int64 NumVerbosityChars : Stats.NumChars)
+		{
+			NumChars += NumVerbosityChars;
+		}
+
+		Output.Logf(
+			TEXT("  %-40s %lld / %lld / %lld / %lld / %lld / %lld / %lld, %lld characters"),
+			*Stats.Category.ToString(),
+			Stats.NumMessages[ELogVerbosity::Fatal],
+			Stats.NumMessages[ELogVerbosity::Error],
+			Stats.NumMessages[ELogVerbosity::Warning],
+			Stats.NumMessages[ELogVerbosity::Display],
+			Stats.NumMessages[ELogVerbosity::Log],
+			Stats.NumMessages[ELogVerbosity::Verbose],
+			Stats.NumMessages[ELogVerbosity::VeryVerbose],
+			NumChars);
+	}
+
+	Output.Logf(TEXT("Most frequent log message templates:"));
+	for (const FTemplateStats& Stats : TopTemplates)
+	{
+		Output.Logf(
+			TEXT("  %8lld (error <= %lld) %s: %s: %s"),
+			Stats.Count,
+			Stats.MaxError,
+			*Stats.Category.ToString(),
+			::ToString(Stats.Verbosity),
+			*Stats.Template);
+	}
+}
+
+bool FLogStatistics::ExportCSV(const FString& FilePath) const
+{
+	TStringBuilder<4096> CategoriesCSV;
+	CategoriesCSV << TEXT("Category,Verbosity,Messages,Characters\n");
+	for (const FCategoryStats& Stats : GetCategoryStats())
+	{
+		for (int32 VerbosityIdx = 1; VerbosityIdx < ELogVerbosity::NumVerbosity; ++VerbosityIdx)
+		{
+			if (Stats.NumMessages[VerbosityIdx] > 0)
+			{
+				CategoriesCSV.Appendf(
+					TEXT("%s,%s,%lld,%lld\n"),
+					*Stats.Category.ToString(),
+					::ToString(static_cast<ELogVerbosity::Type>(VerbosityIdx)),
+					Stats.NumMessages[VerbosityIdx],
+					Stats.NumChars[VerbosityIdx]);
+			}
+		}
+	}
+
+	TStringBuilder<4096> TemplatesCSV;
+	TemplatesCSV << TEXT("Count,MaxError,Category,Verbosity,Template\n");
+	for (const FTemplateStats& Stats : GetTopTemplates())
+	{
+		TemplatesCSV.Appendf(
+			TEXT("%lld,%lld,%s,%s,%s\n"),
+			Stats.Count,
+			Stats.MaxError,
+			*Stats.Category.ToString(),
+			::ToString(Stats.Verbosity),
+			*EscapeCSV(Stats.Template));
+	}
+
+	const FString TemplatesFilePath = FPaths::Combine(
+		FPaths::GetPath(FilePath),
+		FPaths::GetBaseFilename(FilePath) + TEXT("-Templates") + FPaths::GetExtension(FilePath, true));
+
+	return FFileHelper::SaveStringToFile(CategoriesCSV.ToView(), *FilePath)
+		&& FFileHelper::SaveStringToFile(TemplatesCSV.ToView(), *TemplatesFilePath);
+}
+
+FString FLogStatistics::MakeTemplate(const TCHAR* Message)
+{
+	TStringBuilder<MaxTemplateLen> Template;
+	VisitTemplate(Message, [&Template](const TCHAR Char) { Template << Char; });
+	return FString{Template.ToView()};
+}
+
+FLogStatistics::FCounters& FLogStatistics::FindOrAddCounters(const FName Category)
+{
+	{
+		FReadScopeLock Lock{CountersLock};
+		if (const TUniquePtr<FCounters>* const Counters = CountersByCategory.Find(Category))
+		{
+			return **Counters;
+		}
+	}
+
+	FWriteScopeLock Lock{CountersLock};
+	TUniquePtr<FCounters>& Counters = CountersByCategory.FindOrAdd(Category);
+	if (!Counters.IsValid())
+	{
+		Counters = MakeUnique<FCounters>();
+	}
+
+	return *Counters;
+}
+
+FLogStatistics::FThreadTemplates& FLogStatistics::GetThreadTemplates()
+{
+	// Only the last used instance is cached, so that threads don't hold on to the templates of destroyed instances
+	// other than that one. Shared, so that it stays valid until the thread logs to another instance or exits.
+	thread_local uint32 CachedInstanceId = 0;
+	thread_local TSharedPtr<FThreadTemplates> CachedTemplates;
+	if (CachedInstanceId == InstanceId)
+	{
+		return *CachedTemplates;
+	}
+
+	const uint32 ThreadId = FPlatformTLS::GetCurrentThreadId();
+	{
+		FScopeLock Lock{&TemplatesCriticalSection};
+		if (const TSharedRef<FThreadTemplates>* const Templates = ThreadTemplates.FindByPredicate(
+				[ThreadId](const TSharedRef<FThreadTemplates>& Thread) { return Thread->ThreadId == ThreadId; }))
+		{
+			CachedTemplates = *Templates;
+		}
+		else
+		{
+			CachedTemplates = ThreadTemplates.Emplace_GetRef(MakeShared<FThreadTemplates>());
+			CachedTemplates->ThreadId = ThreadId;
+		}
+	}
+
+	CachedInstanceId = InstanceId;
+	return *CachedTemplates;
+}
+
+void FLogStatistics::AddTemplate(
+	const TCHAR* Message, const uint32 TemplateHash, const ELogVerbosity::Type Verbosity, const FName Category)
+{
+	const uint32 Key = HashCombineFast(TemplateHash, HashCombineFast(GetTypeHash(Category), Verbosity));
+
+	FThreadTemplates& Thread = GetThreadTemplates();
+	FScopeLock Lock{&Thread.CriticalSection};
+
+	if (const int32* const CandidateIdx = Thread.CandidateIndices.Find(Key))
+	{
+		++Thread.Candidates[*CandidateIdx].Stats.Count;
+		return;
+	}
+
+	// New template replaces the least frequent one once all candidates are taken, inheriting its count
+	int32 CandidateIdx = Thread.Candidates.Num();
+	int64 InheritedCount = 0;
+	if (Thread.Candidates.Num() < MaxTemplates * TemplateCandidatesPerTemplate)
+	{
+		Thread.Candidates.AddDefaulted();
+	}
+	else
+	{
+		CandidateIdx = 0;
+		for (int32 Idx = 1; Idx < Thread.Candidates.Num(); ++Idx)
+		{
+			if (Thread.Candidates[Idx].Stats.Count < Thread.Candidates[CandidateIdx].Stats.Count)
+			{
+				CandidateIdx = Idx;
+			}
+		}
+
+		InheritedCount = Thread.Candidates[CandidateIdx].Stats.Count;
+		Thread.CandidateIndices.Remove(Thread.Candidates[CandidateIdx].Key);
+	}
+
+	// Template is rebuilt in place, reusing the allocation of the replaced one
+	FTemplateCandidate& Candidate = Thread.Candidates[CandidateIdx];
+	Candidate.Key = Key;
+	Candidate.Stats.Template.Reset();
+	VisitTemplate(Message, [&Candidate](const TCHAR Char) { Candidate.Stats.Template.AppendChar(Char); });
+	Candidate.Stats.Category = Category;
+	Candidate.Stats.Verbosity = Verbosity;
+	Candidate.Stats.Count = InheritedCount + 1;
+	Candidate.Stats.MaxError = InheritedCount;
+	Thread.CandidateIndices.Add(Key, CandidateIdx);
+}
+
+}  // namespace Zkz
@@ -1,11 +1,15 @@
 ﻿#include "Zakazane/Logging.h"
 
+#include "Algo/StableSort.h"
 #include "Engine/Engine.h"
 #include "Modules/ModuleManager.h"
 #include "Logging/MessageLog.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "Misc/UObjectToken.h"
 #include "Widgets/Notifications/SNotificationList.h"
+#include "HAL/IConsoleManager.h"
+#include "Zakazane/BinaryLog.h"
+#include "Zakazane/LogRepeatFilter.h"
 #include "Zakazane/Object.h"
 #include "Zakazane/ReturnIfMacros.h"
 
@@ -15,6 +19,99 @@
 
 namespace Logging::Private
 {
+float RepeatWindow = 2.0f;
+
+FAutoConsoleVariableRef CVarRepeatWindow{
+	TEXT("Zkz.Log.RepeatWindow"),
+	RepeatWindow,
+	TEXT("Seconds for which repeats of a user error or on-screen message are suppressed after it's logged, then "
+		 "summarized with their count. Zero or less logs every repeat."),
+	ECVF_Default};
+
+Zkz::FLogRepeatFilter& GetRepeatFilter()
+{
+	static Zkz::FLogRepeatFilter RepeatFilter;
+	return RepeatFilter;
+}
+
+/// Path the message is logged through. Both share the repeat filter, while their severities overlap as plain ints.
+enum class ERepeatSource : uint8
+{
+	UserError,
+	ScreenAndConsole,
+};
+
+uint32 MakeRepeatKey(
+	const ERepeatSource Source,
+	const FName Category,
+	const int32 Severity,
+	const FString& Message,
+	const UObject* ContextObject)
+{
+	uint32 Key = HashCombineFast(GetTypeHash(Source), GetTypeHash(Category));
+	Key = HashCombineFast(Key, GetTypeHash(Severity));
+	Key = HashCombineFast(Key, GetTypeHash(Message));
+	return HashCombineFast(Key, GetTypeHash(ContextObject));
+}
+
+FString MakeRepeatSummary(const FString& Message, const int32 NumRepeats)
+{
+	return FString::Printf(TEXT("%s (%d repeats)"), *Message, NumRepeats);
+}
+
+void LogToScreenAndConsole(
+	const FLogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FString& Message, const uint64 ScreenKey)
+{
+	if (IsValid(GEngine))
+	{
+		const FColor Color = [Verbosity]
+		{
+			switch (Verbosity)
+			{
+				case ELogVerbosity::Fatal:
+					[[fallthrough]];
+				case ELogVerbosity::Error:
+					return FColor::Red;
+				case ELogVerbosity::Warning:
+					return FColor::Yellow;
+				default:
+					return FColor::White;
+			}
+		}();
+
+		// Stable key, so that a repeated message replaces itself on screen rather than stacking
+		GEngine->AddOnScreenDebugMessage(ScreenKey, 5.0f, Color, Message);
+	}
+
+	switch (Verbosity)
+	{
+		case ELogVerbosity::Fatal:
+			UE_LOG_REF(Category, Fatal, TEXT("%s"), *Message);
+			break;
+		case ELogVerbosity::Error:
+			UE_LOG_REF(Category, Error, TEXT("%s"), *Message);
+			break;
+		case ELogVerbosity::Warning:
+			UE_LOG_REF(Category, Warning, TEXT("%s"), *Message);
+			break;
+		case ELogVerbosity::Display:
+			UE_LOG_REF(Category, Display, TEXT("%s"), *Message);
+			break;
+		case ELogVerbosity::Log:
+			UE_LOG_REF(Category, Log, TEXT("%s"), *Message);
+			break;
+		case ELogVerbosity::Verbose:
+			UE_LOG_REF(Category, Verbose, TEXT("%s"), *Message);
+			break;
+		case ELogVerbosity::VeryVerbose:
+			UE_LOG_REF(Category, VeryVerbose, TEXT("%s"), *Message);
+			break;
+		default: ;
+			UE_LOG_REF(Category, Error, TEXT("[unexpected verbosity] %s"), *Message);
+			break;
+	}
+}
+
 #if WITH_EDITOR
 
 FString GetReadableContextObjectName(const UObject& Object)
@@ -39,6 +136,21 @@ FString GetReadableContextObjectName(const UObject& Object)
 #endif
 }
 
+void UZkzLogSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UZkzLogSubsystem::Tick));
+}
+
+void UZkzLogSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	FlushUserErrors();
+
+	Super::Deinitialize();
+}
+
 void UZkzLogSubsystem::LogUserError(
 	const FLogCategoryBase& LogCategory,
 	const EMessageSeverity::Type Severity,
@@ -46,20 +158,147 @@ void UZkzLogSubsystem::LogUserError(
 	const UObject* ContextObject,
 	const bool bTryPointToSourceObject)
 {
+#if ZKZ_WITH_BINARY_LOG
+	Zkz::BinaryLog::Record(
+		LogCategory.GetCategoryName(), FMessageLog::GetLogVerbosity(Severity), TEXT("%s"), *MessageStr);
+#endif
+
+	LogUnrecordedUserError(LogCategory, Severity, MessageStr, ContextObject, bTryPointToSourceObject);
+}
+
+void UZkzLogSubsystem::LogUnrecordedUserError(
+	const FLogCategoryBase& LogCategory,
+	const EMessageSeverity::Type Severity,
+	const FString& MessageStr,
+	const UObject* ContextObject,
+	const bool bTryPointToSourceObject)
+{
+	using namespace Logging::Private;
+
+	const bool bEmit = GetRepeatFilter().Filter(
+		MakeRepeatKey(ERepeatSource::UserError, LogCategory.GetCategoryName(), Severity, MessageStr, ContextObject),
+		FPlatformTime::Seconds(),
+		RepeatWindow,
+		[&]
+		{
+			return [WeakThis = TWeakObjectPtr<UZkzLogSubsystem>{this},
+					&LogCategory,
+					Severity,
+					MessageStr,
+					WeakContextObject = TWeakObjectPtr<const UObject>{ContextObject},
+					bTryPointToSourceObject](const int32 NumRepeats)
+			{
+				if (UZkzLogSubsystem* const This = WeakThis.Get())
+				{
+					This->EmitUserError(
+						LogCategory,
+						Severity,
+						MakeRepeatSummary(MessageStr, NumRepeats),
+						WeakContextObject.Get(),
+						bTryPointToSourceObject);
+				}
+			};
+		});
+	ZKZ_RETURN_IF(!bEmit);
+
+	EmitUserError(LogCategory, Severity, MessageStr, ContextObject, bTryPointToSourceObject);
+}
+
+void UZkzLogSubsystem::EmitUserError(
+	const FLogCategoryBase& LogCategory,
+	const EMessageSeverity::Type Severity,
+	const FString& MessageStr,
+	const UObject* ContextObject,
+	const bool bTryPointToSourceObject)
+{
 #if WITH_EDITOR
-	const FName LogCategoryName = LogCategory.GetCategoryName();
+	QueuedUserErrors.Enqueue(
+		FQueuedUserError{
+			LogCategory.GetCategoryName(), Severity, MessageStr, ContextObject, bTryPointToSourceObject});
+#endif
 
-	// suppressing because logging is done independently, so it's universal for editor and build
-	FMessageLog& MessageLogInstance = FMessageLog{LogCategoryName}.SuppressLoggingToOutputLog();
+	// Log to console right away, so that the order with other logs is kept
+	const TCHAR* const LogColor = FMessageLog::GetLogColor(Severity);
+	if (LogColor)
+	{
+		SET_WARN_COLOR(LogColor);
+	}
 
-	TSharedRef<FTokenizedMessage> TokenizedMessage = MessageLogInstance.AddMessage(
-		FTokenizedMessage::Create(Severity, FText::FromString(MessageStr)));
+	FMsg::Logf(
+		__FILE__,
+		__LINE__,
+		LogCategory.GetCategoryName(),
+		FMessageLog::GetLogVerbosity(Severity),
+		TEXT("%s"),
+		*MessageStr);
+
+	CLEAR_WARN_COLOR();
+}
 
+void UZkzLogSubsystem::FlushUserErrors()
+{
+#if WITH_EDITOR
+	check(IsInGameThread());
+
+	TArray<FQueuedUserError> UserErrors;
+	FQueuedUserError UserError;
+	while (QueuedUserErrors.Dequeue(UserError))
+	{
+		UserErrors.Emplace(MoveTemp(UserError));
+	}
+
+	ZKZ_RETURN_IF(UserErrors.IsEmpty());
+
+	// Stable, so that the messages of a category keep their order
+	Algo::StableSortBy(UserErrors, &FQueuedUserError::LogCategoryName, FNameLexicalLess{});
+
+	TArray<TSharedRef<FTokenizedMessage>> TokenizedMessages;
+	for (int32 FirstIdx = 0; FirstIdx < UserErrors.Num();)
+	{
+		const FName LogCategoryName = UserErrors[FirstIdx].LogCategoryName;
+
+		TokenizedMessages.Reset();
+		int32 EndIdx = FirstIdx;
+		for (; EndIdx < UserErrors.Num() && UserErrors[EndIdx].LogCategoryName == LogCategoryName; ++EndIdx)
+		{
+			TokenizedMessages.Emplace(CreateTokenizedMessage(UserErrors[EndIdx]));
+		}
+
+		// suppressing because logging is done independently, so it's universal for editor and build
+		FMessageLog MessageLogInstance{LogCategoryName};
+		MessageLogInstance.SuppressLoggingToOutputLog();
+		MessageLogInstance.AddMessages(TokenizedMessages);
+		MessageLogInstance.Flush();
+
+		OnUserErrorsFlushed.Broadcast(LogCategoryName, TokenizedMessages);
+
+		FirstIdx = EndIdx;
+	}
+
+	// Notification opens the message log of the most recent error
+	NotifyUserErrors(UserErrors.Last().LogCategoryName, UserErrors);
+#endif
+}
+
+bool UZkzLogSubsystem::Tick(float)
+{
+	Logging::Private::GetRepeatFilter().Tick(FPlatformTime::Seconds());
+	FlushUserErrors();
+	return true;
+}
+
+#if WITH_EDITOR
+TSharedRef<FTokenizedMessage> UZkzLogSubsystem::CreateTokenizedMessage(const FQueuedUserError& UserError) const
+{
+	TSharedRef<FTokenizedMessage> TokenizedMessage =
+		FTokenizedMessage::Create(UserError.Severity, FText::FromString(UserError.MessageStr));
+
+	const UObject* const ContextObject = UserError.ContextObject.Get();
 	if (IsValid(ContextObject))
 	{
 		const UObject* ObjectToLink = [&]
 		{
-			if (bTryPointToSourceObject)
+			if (UserError.bTryPointToSourceObject)
 			{
 				const UObject* EditorCounterpartObject =
 					Zkz::Editor::TryGetEditorCounterpartObject(*ContextObject);
@@ -76,12 +315,18 @@ void UZkzLogSubsystem::LogUserError(
 		TokenizedMessage->AddToken(FUObjectToken::Create(ObjectToLink, FText::FromString(ObjectToLinkName)));
 	}
 
+	return TokenizedMessage;
+}
+
+void UZkzLogSubsystem::NotifyUserErrors(
+	const FName LogCategoryName, const TConstArrayView<FQueuedUserError> UserErrors)
+{
 	if (!MessageNotificationActive.IsValid() || MessageNotificationActive->GetCompletionState() ==
 	    SNotificationItem::CS_Success)
 	{
 		// Add notification
 		FNotificationInfo Info(FText::FromString(TEXT("Error occured")));
-		Info.SubText = FText::FromString(MessageStr);
+		Info.SubText = FText::FromString(UserErrors.Last().MessageStr);
 		Info.bFireAndForget = false;
 		Info.bUseThrobber = false;
 		Info.ExpireDuration = 0;
@@ -133,47 +378,38 @@ void UZkzLogSubsystem::LogUserError(
 		MessageNotificationActive = FSlateNotificationManager::Get().AddNotification(Info);
 
 		MessageNotificationsToDisplay.Empty();
-		MessageNotificationsToDisplay.Emplace(MessageStr);
+		if (UserErrors.Num() == 1)
+		{
+			MessageNotificationsToDisplay.Emplace(UserErrors[0].MessageStr);
+			return;
+		}
 	}
 	else
 	{
 		MessageNotificationActive->Pulse(FLinearColor::Red);
-
-		MessageNotificationsToDisplay.Emplace(MessageStr);
-		if (MessageNotificationsToDisplay.Num() > 10)
-		{
-			MessageNotificationsToDisplay.RemoveAt(0);
-		}
-
-		MessageNotificationActive->SetText(
-			FText::FromString(
-				FString::Printf(
-					TEXT("Error occured (%d)"),
-					MessageNotificationsToDisplay.Num())));
-
-		MessageNotificationActive->SetSubText(FText::FromString(ConstructNotificationErrorString()));
 	}
 
-	MessageLogInstance.Flush();
-#endif
+	// Only the last few fit in the notification
+	constexpr int32 MaxMessagesToDisplay = 10;
+	for (const FQueuedUserError& UserError : UserErrors.Right(MaxMessagesToDisplay))
+	{
+		MessageNotificationsToDisplay.Emplace(UserError.MessageStr);
+	}
 
-	// Log to console
-	const TCHAR* const LogColor = FMessageLog::GetLogColor(Severity);
-	if (LogColor)
+	if (MessageNotificationsToDisplay.Num() > MaxMessagesToDisplay)
 	{
-		SET_WARN_COLOR(LogColor);
+		MessageNotificationsToDisplay.RemoveAt(0, MessageNotificationsToDisplay.Num() - MaxMessagesToDisplay);
 	}
 
-	FMsg::Logf(
-		__FILE__,
-		__LINE__,
-		LogCategory.GetCategoryName(),
-		FMessageLog::GetLogVerbosity(Severity),
-		TEXT("%s"),
-		*MessageStr);
+	MessageNotificationActive->SetText(
+		FText::FromString(
+			FString::Printf(
+				TEXT("Error occured (%d)"),
+				MessageNotificationsToDisplay.Num())));
 
-	CLEAR_WARN_COLOR();
+	MessageNotificationActive->SetSubText(FText::FromString(ConstructNotificationErrorString()));
 }
+#endif
 
 #if NO_LOGGING
 ZAKAZANEUTILITIES_API void LogUserError(
@@ -215,53 +451,36 @@ void LogToScreenAndConsole(const FNoLoggingCategory& Category, ELogVerbosity::Ty
 
 void LogToScreenAndConsole(const FLogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FString& Message)
 {
-	if (IsValid(GEngine))
-	{
-		const FColor Color = [Verbosity]
+#if ZKZ_WITH_BINARY_LOG
+	// Every repeat is recorded, only the text output is filtered
+	BinaryLog::Record(Category.GetCategoryName(), Verbosity, TEXT("%s"), *Message);
+#endif
+
+	LoggingPrivate::LogUnrecordedToScreenAndConsole(Category, Verbosity, Message);
+}
+
+void LoggingPrivate::LogUnrecordedToScreenAndConsole(
+	const FLogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FString& Message)
+{
+	using namespace Logging::Private;
+
+	const uint32 Key =
+		MakeRepeatKey(ERepeatSource::ScreenAndConsole, Category.GetCategoryName(), Verbosity, Message, nullptr);
+	const bool bEmit = GetRepeatFilter().Filter(
+		Key,
+		FPlatformTime::Seconds(),
+		RepeatWindow,
+		[&]
 		{
-			switch (Verbosity)
+			return [&Category, Verbosity, Message, Key](const int32 NumRepeats)
 			{
-				case ELogVerbosity::Fatal:
-					[[fallthrough]];
-				case ELogVerbosity::Error:
-					return FColor::Red;
-				case ELogVerbosity::Warning:
-					return FColor::Yellow;
-				default:
-					return FColor::White;
-			}
-		}();
-
-		GEngine->AddOnScreenDebugMessage(-1, 5.0f, Color, Message);
-	}
+				Logging::Private::LogToScreenAndConsole(
+					Category, Verbosity, MakeRepeatSummary(Message, NumRepeats), Key);
+			};
+		});
+	ZKZ_RETURN_IF(!bEmit);
 
-	switch (Verbosity)
-	{
-		case ELogVerbosity::Fatal:
-			UE_LOG_REF(Category, Fatal, TEXT("%s"), *Message);
-			break;
-		case ELogVerbosity::Error:
-			UE_LOG_REF(Category, Error, TEXT("%s"), *Message);
-			break;
-		case ELogVerbosity::Warning:
-			UE_LOG_REF(Category, Warning, TEXT("%s"), *Message);
-			break;
-		case ELogVerbosity::Display:
-			UE_LOG_REF(Category, Display, TEXT("%s"), *Message);
-			break;
-		case ELogVerbosity::Log:
-			UE_LOG_REF(Category, Log, TEXT("%s"), *Message);
-			break;
-		case ELogVerbosity::Verbose:
-			UE_LOG_REF(Category, Verbose, TEXT("%s"), *Message);
-			break;
-		case ELogVerbosity::VeryVerbose:
-			UE_LOG_REF(Category, VeryVerbose, TEXT("%s"), *Message);
-			break;
-		default: ;
-			UE_LOG_REF(Category, Error, TEXT("[unexpected verbosity] %s"), *Message);
-			break;
-	}
+	Logging::Private::LogToScreenAndConsole(Category, Verbosity, Message, Key);
 }
 
 void LogUserError(
@@ -279,6 +498,21 @@ void LogUserError(
 	LogSubsystem->LogUserError(LogCategory, Severity, MessageStr, ContextObject, bTryPointToSourceObject);
 }
 
+void LoggingPrivate::LogUnrecordedUserError(
+	const FLogCategoryBase& LogCategory,
+	const EMessageSeverity::Type Severity,
+	const FString& MessageStr,
+	const UObject* ContextObject,
+	const bool bTryPointToSourceObject)
+{
+	ZKZ_RETURN_IF_INVALID(GEngine);
+
+	UZkzLogSubsystem* const LogSubsystem = GEngine->GetEngineSubsystem<UZkzLogSubsystem>();
+	ZKZ_RETURN_IF_INVALID(LogSubsystem);
+
+	LogSubsystem->LogUnrecordedUserError(LogCategory, Severity, MessageStr, ContextObject, bTryPointToSourceObject);
+}
+
 #if NO_LOGGING
 ZAKAZANEUTILITIES_API void LogUserError(
 	const FNoLoggingCategory& LogCategory,
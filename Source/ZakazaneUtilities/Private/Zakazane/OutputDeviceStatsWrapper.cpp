@@ -2,13 +2,76 @@
 
 #include "Zakazane/OutputDeviceStatsWrapper.h"
 
-FOutputDeviceStatsWrapper::FOutputDeviceStatsWrapper(FOutputDevice* InOutputDevice) : OutputDevice{InOutputDevice}
+#include "Misc/ScopeRWLock.h"
+#include "Zakazane/ReturnIfMacros.h"
+
+namespace OutputDeviceStatsWrapper::Private
+{
+int32 ToIndex(const ELogVerbosity::Type Verbosity)
+{
+	return Verbosity & ELogVerbosity::VerbosityMask;
+}
+
+int32 SumWorseThan(TFunctionRef<int32(ELogVerbosity::Type)> GetNumMessages, const ELogVerbosity::Type Verbosity)
+{
+	int32 Result = 0;
+
+	for (int32 VerbosityIdx = ToIndex(Verbosity); VerbosityIdx > 0; --VerbosityIdx)
+	{
+		Result += GetNumMessages(static_cast<ELogVerbosity::Type>(VerbosityIdx));
+	}
+
+	return Result;
+}
+}  // namespace OutputDeviceStatsWrapper::Private
+
+int32 FOutputDeviceStatsWrapper::FSnapshot::GetNumMessages(const ELogVerbosity::Type Verbosity) const
+{
+	return NumMessagesByVerbosity[OutputDeviceStatsWrapper::Private::ToIndex(Verbosity)];
+}
+
+int32 FOutputDeviceStatsWrapper::FSnapshot::GetNumMessagesWorseThan(const ELogVerbosity::Type Verbosity) const
+{
+	return OutputDeviceStatsWrapper::Private::SumWorseThan(
+		[this](const ELogVerbosity::Type InVerbosity) { return GetNumMessages(InVerbosity); }, Verbosity);
+}
+
+int32 FOutputDeviceStatsWrapper::FSnapshot::GetNumMessages(
+	const FName Category, const ELogVerbosity::Type Verbosity) const
+{
+	const TStaticArray<int32, ELogVerbosity::NumVerbosity>* const Counts = NumMessagesByCategory.Find(Category);
+	return Counts == nullptr ? 0 : (*Counts)[OutputDeviceStatsWrapper::Private::ToIndex(Verbosity)];
+}
+
+FOutputDeviceStatsWrapper::FSnapshot& FOutputDeviceStatsWrapper::FSnapshot::operator+=(const FSnapshot& Other)
+{
+	for (int32 VerbosityIdx = 0; VerbosityIdx < ELogVerbosity::NumVerbosity; ++VerbosityIdx)
+	{
+		NumMessagesByVerbosity[VerbosityIdx] += Other.NumMessagesByVerbosity[VerbosityIdx];
+	}
+
+	for (const auto& [Category, OtherCounts] : Other.NumMessagesByCategory)
+	{
+		TStaticArray<int32, ELogVerbosity::NumVerbosity>& Counts =
+			NumMessagesByCategory.FindOrAdd(Category, TStaticArray<int32, ELogVerbosity::NumVerbosity>{InPlace, 0});
+		for (int32 VerbosityIdx = 0; VerbosityIdx < ELogVerbosity::NumVerbosity; ++VerbosityIdx)
+		{
+			Counts[VerbosityIdx] += OtherCounts[VerbosityIdx];
+		}
+	}
+
+	return *this;
+}
+
+FOutputDeviceStatsWrapper::FOutputDeviceStatsWrapper(FOutputDevice* InOutputDevice, const bool bInCountByCategory)
+	: OutputDevice{InOutputDevice}
+	, bCountByCategory{bInCountByCategory}
 {
 }
 
 void FOutputDeviceStatsWrapper::Serialize(const TCHAR* V, const ELogVerbosity::Type Verbosity, const FName& Category)
 {
-	IncrementNumMessages(Verbosity);
+	IncrementNumMessages(Verbosity, Category);
 
 	if (OutputDevice != nullptr)
 	{
@@ -19,7 +82,7 @@ void FOutputDeviceStatsWrapper::Serialize(const TCHAR* V, const ELogVerbosity::T
 void FOutputDeviceStatsWrapper::Serialize(
 	const TCHAR* V, const ELogVerbosity::Type Verbosity, const FName& Category, const double Time)
 {
-	IncrementNumMessages(Verbosity);
+	IncrementNumMessages(Verbosity, Category);
 
 	if (OutputDevice != nullptr)
 	{
@@ -27,25 +90,121 @@ void FOutputDeviceStatsWrapper::Serialize(
 	}
 }
 
+bool FOutputDeviceStatsWrapper::CanBeUsedOnMultipleThreads() const
+{
+	return OutputDevice == nullptr || OutputDevice->CanBeUsedOnMultipleThreads();
+}
+
 int32 FOutputDeviceStatsWrapper::GetNumMessages(const ELogVerbosity::Type Verbosity) const
 {
-	const int32* const FoundNumMessages = NumMessagesByVerbosity.Find(Verbosity);
-	return FoundNumMessages == nullptr ? 0 : *FoundNumMessages;
+	return TotalCounters.NumMessages[OutputDeviceStatsWrapper::Private::ToIndex(Verbosity)].load(
+		std::memory_order_relaxed);
 }
 
 int32 FOutputDeviceStatsWrapper::GetNumMessagesWorseThan(const ELogVerbosity::Type Verbosity) const
 {
-	int32 Result = 0;
+	return OutputDeviceStatsWrapper::Private::SumWorseThan(
+		[this](const ELogVerbosity::Type InVerbosity) { return GetNumMessages(InVerbosity); }, Verbosity);
+}
+
+int32 FOutputDeviceStatsWrapper::GetNumMessages(const FName Category, const ELogVerbosity::Type Verbosity) const
+{
+	FReadScopeLock Lock{CategoryLock};
 
-	for (int32 VerbosityIdx = Verbosity; VerbosityIdx > 0; --VerbosityIdx)
+	const TUniquePtr<FCounters>* const Counters = NumMessagesByCategory.Find(Category);
+	ZKZ_RETURN_IF(Counters == nullptr, 0);
+
+	return (*Counters)->NumMessages[OutputDeviceStatsWrapper::Private::ToIndex(Verbosity)].load(
+		std::memory_order_relaxed);
+}
+
+FOutputDeviceStatsWrapper::FSnapshot FOutputDeviceStatsWrapper::GetSnapshot() const
+{
+	FSnapshot Snapshot;
+	for (int32 VerbosityIdx = 0; VerbosityIdx < ELogVerbosity::NumVerbosity; ++VerbosityIdx)
 	{
-		Result += GetNumMessages(static_cast<ELogVerbosity::Type>(VerbosityIdx));
+		Snapshot.NumMessagesByVerbosity[VerbosityIdx] = TotalCounters.NumMessages[VerbosityIdx].load(
+			std::memory_order_relaxed);
 	}
 
-	return Result;
+	FReadScopeLock Lock{CategoryLock};
+	Snapshot.NumMessagesByCategory.Reserve(NumMessagesByCategory.Num());
+	for (const auto& [Category, Counters] : NumMessagesByCategory)
+	{
+		TStaticArray<int32, ELogVerbosity::NumVerbosity>& Counts = Snapshot.NumMessagesByCategory.Add(Category);
+		for (int32 VerbosityIdx = 0; VerbosityIdx < ELogVerbosity::NumVerbosity; ++VerbosityIdx)
+		{
+			Counts[VerbosityIdx] = Counters->NumMessages[VerbosityIdx].load(std::memory_order_relaxed);
+		}
+	}
+
+	return Snapshot;
+}
+
+void FOutputDeviceStatsWrapper::Merge(const FSnapshot& Snapshot)
+{
+	for (int32 VerbosityIdx = 0; VerbosityIdx < ELogVerbosity::NumVerbosity; ++VerbosityIdx)
+	{
+		TotalCounters.NumMessages[VerbosityIdx].fetch_add(
+			Snapshot.NumMessagesByVerbosity[VerbosityIdx], std::memory_order_relaxed);
+	}
+
+	ZKZ_RETURN_IF(!bCountByCategory);
+
+	for (const auto& [Category, Counts] : Snapshot.NumMessagesByCategory)
+	{
+		FCounters& Counters = FindOrAddCategoryCounters(Category);
+		for (int32 VerbosityIdx = 0; VerbosityIdx < ELogVerbosity::NumVerbosity; ++VerbosityIdx)
+		{
+			Counters.NumMessages[VerbosityIdx].fetch_add(Counts[VerbosityIdx], std::memory_order_relaxed);
+		}
+	}
 }
 
-void FOutputDeviceStatsWrapper::IncrementNumMessages(const ELogVerbosity::Type Verbosity)
+void FOutputDeviceStatsWrapper::Reset()
 {
-	++NumMessagesByVerbosity.FindOrAdd(Verbosity, 0);
-}
\ No newline at end of file
+	for (std::atomic<int32>& NumMessages : TotalCounters.NumMessages)
+	{
+		NumMessages.store(0, std::memory_order_relaxed);
+	}
+
+	FReadScopeLock Lock{CategoryLock};
+	for (const auto& [Category, Counters] : NumMessagesByCategory)
+	{
+		for (std::atomic<int32>& NumMessages : Counters->NumMessages)
+		{
+			NumMessages.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+FOutputDeviceStatsWrapper::FCounters& FOutputDeviceStatsWrapper::FindOrAddCategoryCounters(const FName Category)
+{
+	{
+		FReadScopeLock Lock{CategoryLock};
+		if (const TUniquePtr<FCounters>* const Counters = NumMessagesByCategory.Find(Category))
+		{
+			return **Counters;
+		}
+	}
+
+	FWriteScopeLock Lock{CategoryLock};
+	TUniquePtr<FCounters>& Counters = NumMessagesByCategory.FindOrAdd(Category);
+	if (!Counters.IsValid())
+	{
+		Counters = MakeUnique<FCounters>();
+	}
+
+	return *Counters;
+}
+
+void FOutputDeviceStatsWrapper::IncrementNumMessages(const ELogVerbosity::Type Verbosity, const FName& Category)
+{
+	const int32 VerbosityIdx = OutputDeviceStatsWrapper::Private::ToIndex(Verbosity);
+	TotalCounters.NumMessages[VerbosityIdx].fetch_add(1, std::memory_order_relaxed);
+
+	if (bCountByCategory)
+	{
+		FindOrAddCategoryCounters(Category).NumMessages[VerbosityIdx].fetch_add(1, std::memory_order_relaxed);
+	}
+}
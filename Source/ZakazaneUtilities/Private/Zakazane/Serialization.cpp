@@ -1,5 +1,8 @@
 ﻿#include "Zakazane/Serialization.h"
 
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/App.h"
 #include "Misc/ScopeExit.h"
 #include "Misc/SlowTask.h"
 #include "Serialization/Csv/CsvParser.h"
@@ -70,12 +73,256 @@ FString ExportToCSV(const UStruct& Struct, const TArrayView<const void*> Objects
 	return Builder.ToString();
 }
 
+namespace
+{
+
+/// Rows imported in parallel are processed in batches of this size: converted on worker threads, then delivered and
+/// their messages replayed on the calling thread
+constexpr int32 ParallelImportBatchSize = 4096;
+
+/// Collects the messages of a row imported on a worker thread, so they can be replayed in row order
+class FRowOutput final : public FOutputDevice
+{
+public:
+	explicit FRowOutput(TArray<TPair<ELogVerbosity::Type, FString>>& InMessages) : Messages{InMessages}
+	{
+	}
+
+	virtual void Serialize(const TCHAR* V, const ELogVerbosity::Type Verbosity, const FName& Category) override
+	{
+		Messages.Emplace(Verbosity, V);
+	}
+
+private:
+	TArray<TPair<ELogVerbosity::Type, FString>>& Messages;
+};
+
+/// Importing object references may find or load objects, which is only safe on the game thread
+bool CanImportInParallel(const TConstArrayView<const FProperty*> Properties)
+{
+	for (const FProperty* const Property : Properties)
+	{
+		TArray<const FStructProperty*> EncounteredStructProperties;
+		ZKZ_RETURN_IF(
+			Property != nullptr
+				&& Property->ContainsObjectReference(
+					EncounteredStructProperties,
+					EPropertyObjectReferenceType::Strong | EPropertyObjectReferenceType::Weak),
+			false);
+	}
+
+	return true;
+}
+
+/// Imports a row into an initialized object. Returns false if the row was skipped, logging why to Output.
+bool ImportRow(
+	const TConstArrayView<const FProperty*> Properties,
+	const TArray<const TCHAR*>& Row,
+	const int32 RowIdx,
+	void* const Object,
+	FOutputDevice* const Output)
+{
+	const int32 NumCells = Row.Num();
+	if (NumCells != Properties.Num())
+	{
+		if (Output != nullptr)
+		{
+			Output->Log(
+				ELogVerbosity::Warning,
+				FString::Format(
+					TEXT(
+						"Warning in line {0}: invalid number of columns. Expected {1} but got {2}. Line ignored.\n"),
+					{RowIdx + 1, NumCells, Properties.Num()}));
+		}
+		return false;
+	}
+
+	for (int32 CellIdx = 0; CellIdx < NumCells; CellIdx++)
+	{
+		const FProperty* const Property = Properties[CellIdx];
+		const FStringView CellText = Row[CellIdx];
+
+		if (Property == nullptr)  // column empty
+		{
+			if (!CellText.IsEmpty())
+			{
+				if (Output != nullptr)
+				{
+					Output->Log(
+						ELogVerbosity::Warning,
+						FString::Format(
+							TEXT("Warning in line {0}, column {1}: expected empty column. Line ignored.\n"),
+							{RowIdx + 1, CellIdx + 1}));
+				}
+
+				return false;
+			}
+
+			continue;
+		}
+
+		if (const FTextProperty* const TextProperty = ExactCastField<const FTextProperty>(Property))
+		{
+			const FText Text = FText::FromStringView(CellText);
+			TextProperty->SetValue_InContainer(Object, Text);
+		}
+		else
+		{
+			FStringOutputDevice PropertyImportOutput;
+			FOutputDeviceStatsWrapper StatsWrapperOutput{&PropertyImportOutput};
+			const FStringView RemainingCellText =
+				Property->ImportText_Direct(CellText.GetData(), Object, nullptr, 0, &StatsWrapperOutput);
+
+			// Property import logs on Log
+			if (StatsWrapperOutput.GetNumMessagesWorseThan(ELogVerbosity::Log) > 0)
+			{
+				if (Output != nullptr)
+				{
+					Output->Log(
+						ELogVerbosity::Warning,
+						FString::Format(
+							TEXT(
+								"Warning in line {0}, column {1}: failed to import property. Line ignored. Detailed message: {2}\n"),
+							{RowIdx + 1, CellIdx + 1, *PropertyImportOutput}));
+				}
+				return false;
+			}
+			else if (!RemainingCellText.IsEmpty())
+			{
+				if (Output != nullptr)
+				{
+					Output->Log(
+						ELogVerbosity::Warning,
+						FString::Format(
+							TEXT("Warning in line {0}, column {1}: unexpected trailing text in value: {2}\n"),
+							{RowIdx + 1, CellIdx + 1, RemainingCellText}));
+				}
+				return false;
+			}
+		}
+	}
+
+
+	return true;
+}
+
+EImportResult ImportRowsInParallel(
+	const UStruct& Struct,
+	const TArray<TArray<const TCHAR*>>& Rows,
+	const TConstArrayView<const FProperty*> Properties,
+	const TFunction<void(const void*)>& LineCallback,
+	FOutputDevice* const Output,
+	const TFunctionRef<bool(int32)> TickSlowTask,
+	const bool bUnorderedCallback)
+{
+	const int32 ObjectSize = Align(Struct.GetStructureSize(), Struct.GetMinAlignment());
+	const int32 NumBuffers = bUnorderedCallback
+		? FMath::Min(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, ParallelImportBatchSize)
+		: ParallelImportBatchSize;
+
+	// Ordered: an object per row of a batch, delivered after the batch is converted.
+	// Unordered: an object per buffer, each buffer converting and delivering a contiguous chunk of the batch.
+	uint8* const Objects =
+		static_cast<uint8*>(FMemory::Malloc(static_cast<SIZE_T>(ObjectSize) * NumBuffers, Struct.GetMinAlignment()));
+	check(Objects);
+
+	ON_SCOPE_EXIT
+	{
+		FMemory::Free(Objects);
+	};
+
+	EImportResult AggregatedResult = EImportResult::Success;
+	TArray<TArray<TPair<ELogVerbosity::Type, FString>>> RowMessages;
+	RowMessages.SetNum(ParallelImportBatchSize);
+	TArray<bool> RowsImported;
+	RowsImported.SetNumZeroed(ParallelImportBatchSize);
+
+	for (int32 BatchStart = 1; BatchStart < Rows.Num(); BatchStart += ParallelImportBatchSize)
+	{
+		const int32 NumBatchRows = FMath::Min(ParallelImportBatchSize, Rows.Num() - BatchStart);
+		ZKZ_RETURN_IF(!TickSlowTask(NumBatchRows), EImportResult::CancelledByUser);
+
+		const auto ImportBatchRow = [&](const int32 BatchRowIdx, void* const Object)
+		{
+			FRowOutput RowOutput{RowMessages[BatchRowIdx]};
+			RowsImported[BatchRowIdx] = ImportRow(
+				Properties,
+				Rows[BatchStart + BatchRowIdx],
+				BatchStart + BatchRowIdx,
+				Object,
+				Output != nullptr ? &RowOutput : nullptr);
+		};
+
+		if (bUnorderedCallback)
+		{
+			const int32 NumChunks = FMath::Min(NumBuffers, NumBatchRows);
+			ParallelFor(
+				NumChunks,
+				[&](const int32 ChunkIdx)
+				{
+					void* const Object = Objects + static_cast<SIZE_T>(ObjectSize) * ChunkIdx;
+					const int32 ChunkEnd = NumBatchRows * (ChunkIdx + 1) / NumChunks;
+					for (int32 BatchRowIdx = NumBatchRows * ChunkIdx / NumChunks; BatchRowIdx < ChunkEnd; ++BatchRowIdx)
+					{
+						Struct.InitializeStruct(Object);
+						ImportBatchRow(BatchRowIdx, Object);
+						if (RowsImported[BatchRowIdx])
+						{
+							LineCallback(Object);
+						}
+						Struct.DestroyStruct(Object);
+					}
+				});
+		}
+		else
+		{
+			ParallelFor(
+				NumBatchRows,
+				[&](const int32 BatchRowIdx)
+				{
+					void* const Object = Objects + static_cast<SIZE_T>(ObjectSize) * BatchRowIdx;
+					Struct.InitializeStruct(Object);
+					ImportBatchRow(BatchRowIdx, Object);
+				});
+		}
+
+		for (int32 BatchRowIdx = 0; BatchRowIdx < NumBatchRows; ++BatchRowIdx)
+		{
+			for (const TPair<ELogVerbosity::Type, FString>& Message : RowMessages[BatchRowIdx])
+			{
+				Output->Log(Message.Key, Message.Value);
+			}
+			RowMessages[BatchRowIdx].Reset();
+
+			if (!RowsImported[BatchRowIdx])
+			{
+				AggregatedResult = EImportResult::Warning;
+			}
+
+			if (!bUnorderedCallback)
+			{
+				void* const Object = Objects + static_cast<SIZE_T>(ObjectSize) * BatchRowIdx;
+				if (RowsImported[BatchRowIdx])
+				{
+					LineCallback(Object);
+				}
+				Struct.DestroyStruct(Object);
+			}
+		}
+	}
+
+	return AggregatedResult;
+}
+
+}  // namespace
+
 EImportResult ImportFromCSV(
 	const UStruct& Struct,
 	const FString& CSV,
 	const TFunction<void(const void*)>& LineCallback,
 	FOutputDevice* const Output,
-	FSlowTask* const SlowTask)
+	FSlowTask* const SlowTask,
+	const EImportFlags Flags)
 {
 	const FCsvParser Parser{CSV};
 
@@ -89,19 +336,11 @@ EImportResult ImportFromCSV(
 		return EImportResult::Error;
 	}
 
-	void* const Object = FMemory::Malloc(Struct.GetStructureSize(), Struct.GetMinAlignment());
-	check(Object);
-
-	ON_SCOPE_EXIT
-	{
-		FMemory::Free(Object);
-	};
-
-	const auto TickSlowTask = [SlowTask, Work = 1.0f / (Parser.GetRows().Num())]
+	const auto TickSlowTask = [SlowTask, Work = 1.0f / (Parser.GetRows().Num())](const int32 NumRows)
 	{
 		if (SlowTask != nullptr)
 		{
-			SlowTask->EnterProgressFrame(Work);
+			SlowTask->EnterProgressFrame(Work * NumRows);
 			ZKZ_RETURN_IF(SlowTask->ShouldCancel(), false);
 		}
 
@@ -110,7 +349,7 @@ EImportResult ImportFromCSV(
 
 	TArray<const FProperty*, TInlineAllocator<16>> Properties;
 
-	ZKZ_RETURN_IF(!TickSlowTask(), EImportResult::CancelledByUser);
+	ZKZ_RETURN_IF(!TickSlowTask(1), EImportResult::CancelledByUser);
 	for (const TCHAR* const Cell : Parser.GetRows()[0])
 	{
 		if (FStringView{Cell}.IsEmpty())
@@ -134,14 +373,32 @@ EImportResult ImportFromCSV(
 		Properties.Emplace(Property);
 	}
 
+	if (EnumHasAnyFlags(Flags, EImportFlags::Parallel) && FApp::ShouldUseThreadingForPerformance()
+		&& CanImportInParallel(Properties))
+	{
+		return ImportRowsInParallel(
+			Struct,
+			Parser.GetRows(),
+			Properties,
+			LineCallback,
+			Output,
+			TickSlowTask,
+			EnumHasAnyFlags(Flags, EImportFlags::UnorderedCallback));
+	}
+
+	void* const Object = FMemory::Malloc(Struct.GetStructureSize(), Struct.GetMinAlignment());
+	check(Object);
+
+	ON_SCOPE_EXIT
+	{
+		FMemory::Free(Object);
+	};
+
 	EImportResult AggregatedResult = EImportResult::Success;
-	FTextBuilder AggregatedMessageBuilder;
 
 	for (int32 RowIdx = 1; RowIdx < Parser.GetRows().Num(); ++RowIdx)
 	{
-		const TArray<const TCHAR*>& Row = Parser.GetRows()[RowIdx];
-
-		ZKZ_RETURN_IF(!TickSlowTask(), EImportResult::CancelledByUser);
+		ZKZ_RETURN_IF(!TickSlowTask(1), EImportResult::CancelledByUser);
 
 		Struct.InitializeStruct(Object);
 
@@ -150,97 +407,12 @@ EImportResult ImportFromCSV(
 			Struct.DestroyStruct(Object);
 		};
 
-		const int32 NumCells = Row.Num();
-		if (NumCells != Properties.Num())
+		if (!ImportRow(Properties, Parser.GetRows()[RowIdx], RowIdx, Object, Output))
 		{
 			AggregatedResult = EImportResult::Warning;
-			if (Output != nullptr)
-			{
-				Output->Log(
-					ELogVerbosity::Warning,
-					FString::Format(
-						TEXT(
-							"Warning in line {0}: invalid number of columns. Expected {1} but got {2}. Line ignored.\n"),
-						{RowIdx + 1, NumCells, Properties.Num()}));
-			}
 			continue;
 		}
 
-		const bool bRowImportSuccessful = [&]
-		{
-			for (int32 CellIdx = 0; CellIdx < NumCells; CellIdx++)
-			{
-				const FProperty* const Property = Properties[CellIdx];
-				const FStringView CellText = Row[CellIdx];
-
-				if (Property == nullptr)  // column empty
-				{
-					if (!CellText.IsEmpty())
-					{
-						AggregatedResult = EImportResult::Warning;
-						if (Output != nullptr)
-						{
-							Output->Log(
-								ELogVerbosity::Warning,
-								FString::Format(
-									TEXT("Warning in line {0}, column {1}: expected empty column. Line ignored.\n"),
-									{RowIdx + 1, CellIdx + 1}));
-						}
-
-						return false;
-					}
-
-					continue;
-				}
-
-				if (const FTextProperty* const TextProperty = ExactCastField<const FTextProperty>(Property))
-				{
-					const FText Text = FText::FromStringView(CellText);
-					TextProperty->SetValue_InContainer(Object, Text);
-				}
-				else
-				{
-					FStringOutputDevice PropertyImportOutput;
-					FOutputDeviceStatsWrapper StatsWrapperOutput{&PropertyImportOutput};
-					const FStringView RemainingCellText =
-						Property->ImportText_Direct(CellText.GetData(), Object, nullptr, 0, &StatsWrapperOutput);
-
-					// Property import logs on Log
-					if (StatsWrapperOutput.GetNumMessagesWorseThan(ELogVerbosity::Log) > 0)
-					{
-						AggregatedResult = EImportResult::Warning;
-						if (Output != nullptr)
-						{
-							Output->Log(
-								ELogVerbosity::Warning,
-								FString::Format(
-									TEXT(
-										"Warning in line {0}, column {1}: failed to import property. Line ignored. Detailed message: {2}\n"),
-									{RowIdx + 1, CellIdx + 1, *PropertyImportOutput}));
-						}
-						return false;
-					}
-					else if (!RemainingCellText.IsEmpty())
-					{
-						AggregatedResult = EImportResult::Warning;
-						if (Output != nullptr)
-						{
-							Output->Log(
-								ELogVerbosity::Warning,
-								FString::Format(
-									TEXT("Warning in line {0}, column {1}: unexpected trailing text in value: {2}\n"),
-									{RowIdx + 1, CellIdx + 1, RemainingCellText}));
-						}
-						return false;
-					}
-				}
-			}
-
-			return true;
-		}();
-
-		ZKZ_CONTINUE_IF(!bRowImportSuccessful);
-
 		LineCallback(Object);
 	}
 
@@ -0,0 +1,160 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#include "Zakazane/TimerWheel.h"
+
+#include "Misc/ScopeLock.h"
+
+namespace Zkz
+{
+
+FTimerWheel::FTimerWheel(const double InTickInterval) : TickInterval{InTickInterval}
+{
+	check(TickInterval > 0.0);
+}
+
+void FTimerWheel::Schedule(const double Delay, FCallback&& Callback)
+{
+	const double NumTicksUnclamped = FMath::CeilToDouble(FMath::Max(Delay, 0.0) / TickInterval);
+	const uint64 NumTicks = FMath::Max<uint64>(1, static_cast<uint64>(NumTicksUnclamped));
+
+	++NumPending;
+	Place(FTimer{CurrentTick + NumTicks, MoveTemp(Callback)});
+}
+
+void FTimerWheel::Advance(const double DeltaTime)
+{
+	TArray<FCallback> ExpiredCallbacks;
+	Advance(DeltaTime, ExpiredCallbacks);
+
+	for (FCallback& Callback : ExpiredCallbacks)
+	{
+		Callback();
+	}
+}
+
+void FTimerWheel::Advance(const double DeltaTime, TArray<FCallback>& OutExpiredCallbacks)
+{
+	AccumulatedTime += DeltaTime;
+
+	while (AccumulatedTime >= TickInterval)
+	{
+		AccumulatedTime -= TickInterval;
+		Tick(OutExpiredCallbacks);
+	}
+}
+
+int32 FTimerWheel::GetNumPending() const
+{
+	return NumPending;
+}
+
+double FTimerWheel::GetTickInterval() const
+{
+	return TickInterval;
+}
+
+void FTimerWheel::Place(FTimer&& Timer)
+{
+	// Timer goes to the lowest level at which it's in the same "cycle" as current tick, i.e. all the higher bits
+	// match. Its slot at that level comes up when the lower bits roll over, which is no later than the expiration.
+	for (int32 Level = 0; Level < NumLevels; ++Level)
+	{
+		const int32 HigherBitsShift = SlotBits * (Level + 1);
+		if ((Timer.ExpirationTick >> HigherBitsShift) == (CurrentTick >> HigherBitsShift))
+		{
+			const uint64 SlotIdx = (Timer.ExpirationTick >> (SlotBits * Level)) & SlotMask;
+			Levels[Level][SlotIdx].Emplace(MoveTemp(Timer));
+			return;
+		}
+	}
+
+	Overflow.Emplace(MoveTemp(Timer));
+}
+
+void FTimerWheel::Tick(TArray<FCallback>& OutExpiredCallbacks)
+{
+	++CurrentTick;
+
+	// Top level cycle complete - timers kept aside may fit in the wheel now
+	if ((CurrentTick & ((uint64{1} << (SlotBits * NumLevels)) - 1)) == 0)
+	{
+		Cascade(Overflow);
+	}
+
+	// Highest to lowest, so that timers cascaded from a higher level to the current lower level slot are cascaded
+	// further down in the same tick
+	for (int32 Level = NumLevels - 1; Level > 0; --Level)
+	{
+		const int32 LevelShift = SlotBits * Level;
+		if ((CurrentTick & ((uint64{1} << LevelShift) - 1)) == 0)
+		{
+			Cascade(Levels[Level][(CurrentTick >> LevelShift) & SlotMask]);
+		}
+	}
+
+	FSlot& ExpiredSlot = Levels[0][CurrentTick & SlotMask];
+	for (FTimer& Timer : ExpiredSlot)
+	{
+		checkSlow(Timer.ExpirationTick == CurrentTick);
+		OutExpiredCallbacks.Emplace(MoveTemp(Timer.Callback));
+	}
+
+	NumPending -= ExpiredSlot.Num();
+	ExpiredSlot.Reset();
+}
+
+void FTimerWheel::Cascade(FSlot& Slot)
+{
+	FSlot CascadedTimers = MoveTemp(Slot);
+	Slot.Reset();
+
+	for (FTimer& Timer : CascadedTimers)
+	{
+		Place(MoveTemp(Timer));
+	}
+}
+
+FSharedTimerWheel& FSharedTimerWheel::Get()
+{
+	static FSharedTimerWheel Instance;
+	return Instance;
+}
+
+void FSharedTimerWheel::Schedule(const double Delay, FTimerWheel::FCallback&& Callback)
+{
+	FScopeLock Lock{&CriticalSection};
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			TEXT("ZkzSharedTimerWheel"), 0.0f, [this](const float DeltaTime) { return Tick(DeltaTime); });
+	}
+
+	TimerWheel.Schedule(Delay, MoveTemp(Callback));
+}
+
+int32 FSharedTimerWheel::GetNumPending() const
+{
+	FScopeLock Lock{&CriticalSection};
+	return TimerWheel.GetNumPending();
+}
+
+bool FSharedTimerWheel::Tick(const float DeltaTime)
+{
+	TArray<FTimerWheel::FCallback> ExpiredCallbacks;
+
+	{
+		FScopeLock Lock{&CriticalSection};
+		TimerWheel.Advance(DeltaTime, ExpiredCallbacks);
+	}
+
+	// Called outside the lock, as callbacks may schedule new timers
+	for (FTimerWheel::FCallback& Callback : ExpiredCallbacks)
+	{
+		Callback();
+	}
+
+	return true;
+}
+
+}  // namespace Zkz
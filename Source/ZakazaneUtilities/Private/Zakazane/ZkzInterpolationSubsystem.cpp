@@ -0,0 +1,275 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#include "Zakazane/ZkzInterpolationSubsystem.h"
+
+#include "Math/VectorRegister.h"
+#include "Zakazane/Interpolation.h"
+
+namespace Zkz::InterpolationPrivate
+{
+
+template <class ValueType>
+void Reset(TInterpolationChannel<ValueType>& Channel, const FGenerationalHandle Handle, const ValueType& Value)
+{
+	const int32* const DenseIdx = Channel.Find(Handle);
+	ZKZ_RETURN_IF_ENSUREMSGF(DenseIdx == nullptr, "Invalid interpolated value handle");
+
+	const int32 SettledIdx = Channel.Settle(*DenseIdx);
+	Channel.Current[SettledIdx] = Value;
+	Channel.Target[SettledIdx] = Value;
+}
+
+template <class ValueType>
+void SetTarget(TInterpolationChannel<ValueType>& Channel, const FGenerationalHandle Handle, const ValueType& Target)
+{
+	const int32* const DenseIdx = Channel.Find(Handle);
+	ZKZ_RETURN_IF_ENSUREMSGF(DenseIdx == nullptr, "Invalid interpolated value handle");
+
+	// Any target wakes the value, even the current one, so that it arrives on the next update, same as the structs
+	Channel.Target[*DenseIdx] = Target;
+	Channel.Wake(*DenseIdx);
+}
+
+template <class ValueType>
+void SetInterpSpeed(
+	TInterpolationChannel<ValueType>& Channel, const FGenerationalHandle Handle, const float InterpSpeed)
+{
+	const int32* const DenseIdx = Channel.Find(Handle);
+	ZKZ_RETURN_IF_ENSUREMSGF(DenseIdx == nullptr, "Invalid interpolated value handle");
+
+	Channel.InterpSpeeds[*DenseIdx] = InterpSpeed;
+}
+
+template <class ValueType>
+ValueType GetCurrent(
+	const TInterpolationChannel<ValueType>& Channel, const FGenerationalHandle Handle, const ValueType& Fallback)
+{
+	const int32* const DenseIdx = Channel.Find(Handle);
+	ZKZ_RETURN_IF_ENSUREMSGF(DenseIdx == nullptr, "Invalid interpolated value handle", Fallback);
+
+	return Channel.Current[*DenseIdx];
+}
+
+template <class ValueType>
+bool IsSettled(const TInterpolationChannel<ValueType>& Channel, const FGenerationalHandle Handle)
+{
+	const int32* const DenseIdx = Channel.Find(Handle);
+	ZKZ_RETURN_IF_ENSUREMSGF(DenseIdx == nullptr, "Invalid interpolated value handle", true);
+
+	return !Channel.IsInMotion(*DenseIdx);
+}
+
+/// Interpolation::TExponentialPolicy for all floats in motion, four at a time
+void UpdateFloats(TInterpolationChannel<float>& Channel, const float DeltaTime)
+{
+	const int32 Num = Channel.NumInMotion;
+	float* const Current = Channel.Current.GetData();
+	const float* const Target = Channel.Target.GetData();
+	const float* const InterpSpeeds = Channel.InterpSpeeds.GetData();
+
+	const Interpolation::TExponentialPolicy<float> DefaultPolicy;
+
+	const VectorRegister4Float DeltaTimeVec = VectorSetFloat1(DeltaTime);
+	const VectorRegister4Float ZeroVec = VectorZeroFloat();
+	const VectorRegister4Float ToleranceVec = VectorSetFloat1(DefaultPolicy.Tolerance);
+
+	int32 Idx = 0;
+	for (; Idx + 4 <= Num; Idx += 4)
+	{
+		const VectorRegister4Float CurrentVec = VectorLoad(Current + Idx);
+		const VectorRegister4Float TargetVec = VectorLoad(Target + Idx);
+		const VectorRegister4Float SpeedVec = VectorLoad(InterpSpeeds + Idx);
+
+		// Fraction of the distance remaining after DeltaTime
+		const VectorRegister4Float Remaining = VectorExp(VectorNegate(VectorMultiply(SpeedVec, DeltaTimeVec)));
+
+		const VectorRegister4Float Dist = VectorSubtract(TargetVec, CurrentVec);
+		const VectorRegister4Float Interpolated = VectorSubtract(TargetVec, VectorMultiply(Dist, Remaining));
+
+		// Non-positive speed and remaining distance within tolerance snap to target, same as the policy
+		const VectorRegister4Float bSnap = VectorBitwiseOr(
+			VectorCompareLE(SpeedVec, ZeroVec),
+			VectorCompareLT(VectorMultiply(VectorAbs(Dist), Remaining), ToleranceVec));
+		VectorStore(VectorSelect(bSnap, TargetVec, Interpolated), Current + Idx);
+	}
+
+	for (; Idx < Num; ++Idx)
+	{
+		Interpolation::TExponentialPolicy<float>{InterpSpeeds[Idx]}.Advance(Current[Idx], Target[Idx], DeltaTime);
+	}
+}
+
+/// Interpolation::TExponentialPolicy for all values in motion
+template <class ValueType>
+void UpdateValues(TInterpolationChannel<ValueType>& Channel, const float DeltaTime)
+{
+	const int32 Num = Channel.NumInMotion;
+	ValueType* const Current = Channel.Current.GetData();
+	const ValueType* const Target = Channel.Target.GetData();
+	const float* const InterpSpeeds = Channel.InterpSpeeds.GetData();
+
+	for (int32 Idx = 0; Idx < Num; ++Idx)
+	{
+		Interpolation::TExponentialPolicy<ValueType>{InterpSpeeds[Idx]}.Advance(Current[Idx], Target[Idx], DeltaTime);
+	}
+}
+
+/// Settles the values which reached their target and broadcasts their arrival
+template <class ValueType, class DelegateType>
+void SettleArrived(TInterpolationChannel<ValueType>& Channel, const DelegateType& OnArrived)
+{
+	TArray<FGenerationalHandle, TInlineAllocator<16>> Arrived;
+	Channel.SettleArrived(Arrived);
+
+	// After settling, so that the callbacks may freely set new targets or remove values
+	for (const FGenerationalHandle Handle : Arrived)
+	{
+		OnArrived.Broadcast(Handle);
+	}
+}
+
+}  // namespace Zkz::InterpolationPrivate
+
+using namespace Zkz::InterpolationPrivate;
+
+void UZkzInterpolationSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UpdateAll(DeltaTime);
+}
+
+TStatId UZkzInterpolationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UZkzInterpolationSubsystem, STATGROUP_Tickables);
+}
+
+void UZkzInterpolationSubsystem::UpdateAll(const float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UZkzInterpolationSubsystem::UpdateAll);
+
+	UpdateFloats(Floats, DeltaTime);
+	UpdateValues(Vectors, DeltaTime);
+	UpdateValues(Quats, DeltaTime);
+
+	SettleArrived(Floats, OnFloatArrived);
+	SettleArrived(Vectors, OnVectorArrived);
+	SettleArrived(Quats, OnQuatArrived);
+}
+
+int32 UZkzInterpolationSubsystem::GetNumInMotion() const
+{
+	return Floats.NumInMotion + Vectors.NumInMotion + Quats.NumInMotion;
+}
+
+// -- Float
+
+UZkzInterpolationSubsystem::FHandle UZkzInterpolationSubsystem::AddFloat(const float Value, const float InterpSpeed)
+{
+	return Floats.Add(Value, InterpSpeed);
+}
+
+void UZkzInterpolationSubsystem::RemoveFloat(const FHandle Handle)
+{
+	Floats.Remove(Handle);
+}
+
+void UZkzInterpolationSubsystem::ResetFloat(const FHandle Handle, const float Value)
+{
+	Reset(Floats, Handle, Value);
+}
+
+void UZkzInterpolationSubsystem::SetFloatTarget(const FHandle Handle, const float Target)
+{
+	SetTarget(Floats, Handle, Target);
+}
+
+void UZkzInterpolationSubsystem::SetFloatInterpSpeed(const FHandle Handle, const float InterpSpeed)
+{
+	SetInterpSpeed(Floats, Handle, InterpSpeed);
+}
+
+float UZkzInterpolationSubsystem::GetFloat(const FHandle Handle) const
+{
+	return GetCurrent(Floats, Handle, 0.0f);
+}
+
+bool UZkzInterpolationSubsystem::IsFloatSettled(const FHandle Handle) const
+{
+	return IsSettled(Floats, Handle);
+}
+
+// -- Vector
+
+UZkzInterpolationSubsystem::FHandle UZkzInterpolationSubsystem::AddVector(
+	const FVector& Value, const float InterpSpeed)
+{
+	return Vectors.Add(Value, InterpSpeed);
+}
+
+void UZkzInterpolationSubsystem::RemoveVector(const FHandle Handle)
+{
+	Vectors.Remove(Handle);
+}
+
+void UZkzInterpolationSubsystem::ResetVector(const FHandle Handle, const FVector& Value)
+{
+	Reset(Vectors, Handle, Value);
+}
+
+void UZkzInterpolationSubsystem::SetVectorTarget(const FHandle Handle, const FVector& Target)
+{
+	SetTarget(Vectors, Handle, Target);
+}
+
+void UZkzInterpolationSubsystem::SetVectorInterpSpeed(const FHandle Handle, const float InterpSpeed)
+{
+	SetInterpSpeed(Vectors, Handle, InterpSpeed);
+}
+
+FVector UZkzInterpolationSubsystem::GetVector(const FHandle Handle) const
+{
+	return GetCurrent(Vectors, Handle, FVector::ZeroVector);
+}
+
+bool UZkzInterpolationSubsystem::IsVectorSettled(const FHandle Handle) const
+{
+	return IsSettled(Vectors, Handle);
+}
+
+// -- Quat
+
+UZkzInterpolationSubsystem::FHandle UZkzInterpolationSubsystem::AddQuat(const FQuat& Value, const float InterpSpeed)
+{
+	return Quats.Add(Value, InterpSpeed);
+}
+
+void UZkzInterpolationSubsystem::RemoveQuat(const FHandle Handle)
+{
+	Quats.Remove(Handle);
+}
+
+void UZkzInterpolationSubsystem::ResetQuat(const FHandle Handle, const FQuat& Value)
+{
+	Reset(Quats, Handle, Value);
+}
+
+void UZkzInterpolationSubsystem::SetQuatTarget(const FHandle Handle, const FQuat& Target)
+{
+	SetTarget(Quats, Handle, Target);
+}
+
+void UZkzInterpolationSubsystem::SetQuatInterpSpeed(const FHandle Handle, const float InterpSpeed)
+{
+	SetInterpSpeed(Quats, Handle, InterpSpeed);
+}
+
+FQuat UZkzInterpolationSubsystem::GetQuat(const FHandle Handle) const
+{
+	return GetCurrent(Quats, Handle, FQuat::Identity);
+}
+
+bool UZkzInterpolationSubsystem::IsQuatSettled(const FHandle Handle) const
+{
+	return IsSettled(Quats, Handle);
+}
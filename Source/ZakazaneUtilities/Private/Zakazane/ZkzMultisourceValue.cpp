@@ -0,0 +1,378 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#include "Zakazane/ZkzMultisourceValue.h"
+
+#include "Zakazane/ReturnIfMacros.h"
+
+namespace Zkz::MultisourceValueStructPrivate
+{
+
+template <class SourceType, class ValueType>
+ValueType ResolveSources(
+	const TArray<SourceType>& Sources, const EZkzMultisourceResolver Resolver, const ValueType DefaultValue)
+{
+	switch (Resolver)
+	{
+	case EZkzMultisourceResolver::Priority:
+	{
+		const SourceType* Winner = nullptr;
+		for (const SourceType& Source : Sources)
+		{
+			if (Winner == nullptr || Source.Priority > Winner->Priority
+				|| (Source.Priority == Winner->Priority && Source.PushOrder > Winner->PushOrder))
+			{
+				Winner = &Source;
+			}
+		}
+
+		return Winner != nullptr ? Winner->Value : DefaultValue;
+	}
+	case EZkzMultisourceResolver::Sum:
+	{
+		ValueType Sum{0};
+		for (const SourceType& Source : Sources)
+		{
+			Sum += Source.Value;
+		}
+
+		return Sum;
+	}
+	case EZkzMultisourceResolver::Product:
+	{
+		ValueType Product{1};
+		for (const SourceType& Source : Sources)
+		{
+			Product *= Source.Value;
+		}
+
+		return Product;
+	}
+	case EZkzMultisourceResolver::Min:
+	{
+		ZKZ_RETURN_IF(Sources.IsEmpty(), DefaultValue);
+
+		ValueType Min = Sources[0].Value;
+		for (const SourceType& Source : Sources)
+		{
+			Min = FMath::Min(Min, Source.Value);
+		}
+
+		return Min;
+	}
+	case EZkzMultisourceResolver::Max:
+	{
+		ZKZ_RETURN_IF(Sources.IsEmpty(), DefaultValue);
+
+		ValueType Max = Sources[0].Value;
+		for (const SourceType& Source : Sources)
+		{
+			Max = FMath::Max(Max, Source.Value);
+		}
+
+		return Max;
+	}
+	}
+
+	checkNoEntry();
+	return DefaultValue;
+}
+
+template <class SourceType, class SerializerType>
+FZkzMultisourceSourceHandle AddSource(
+	TArray<SourceType>& Sources, SerializerType& Serializer, int32& LastSourceId, SourceType&& NewSource)
+{
+	const auto IsInUse = [&Sources](const int32 Id)
+	{ return Sources.ContainsByPredicate([Id](const SourceType& Source) { return Source.Id == Id; }); };
+
+	// Skips zero on wrap around, as zero marks an unset handle, as well as ids still in use after wrapping around
+	do
+	{
+		LastSourceId = LastSourceId == MAX_int32 ? 1 : LastSourceId + 1;
+	} while (IsInUse(LastSourceId));
+
+	NewSource.Id = LastSourceId;
+
+	Serializer.MarkItemDirty(Sources.Emplace_GetRef(MoveTemp(NewSource)));
+	return FZkzMultisourceSourceHandle{LastSourceId};
+}
+
+/// Returns false if there was no source with the handle's id
+template <class SourceType, class SerializerType>
+bool RemoveSource(TArray<SourceType>& Sources, SerializerType& Serializer, FZkzMultisourceSourceHandle& Handle)
+{
+	ZKZ_RETURN_IF(!Handle.IsSet(), false);
+
+	const int32 Id = Handle.Id;
+	Handle = FZkzMultisourceSourceHandle{};
+
+	// Order doesn't matter for any resolver - priority ties are broken by push order
+	const int32 SourceIdx = Sources.IndexOfByPredicate([Id](const SourceType& Source) { return Source.Id == Id; });
+	ZKZ_RETURN_IF(SourceIdx == INDEX_NONE, false);
+
+	Sources.RemoveAtSwap(SourceIdx, EAllowShrinking::No);
+
+	Serializer.MarkArrayDirty();
+	return true;
+}
+
+/// Makes sure sources pushed from now on don't reuse ids of the given ones, e.g. after loading data saved before the
+/// counters were saved along with the sources
+template <class SourceType>
+void RestoreLastSourceId(const TArray<SourceType>& Sources, int32& LastSourceId)
+{
+	for (const SourceType& Source : Sources)
+	{
+		LastSourceId = FMath::Max(LastSourceId, Source.Id);
+	}
+}
+
+/// @see RestoreLastSourceId
+template <class SourceType>
+void RestoreLastPushOrder(const TArray<SourceType>& Sources, int64& LastPushOrder)
+{
+	for (const SourceType& Source : Sources)
+	{
+		LastPushOrder = FMath::Max(LastPushOrder, Source.PushOrder);
+	}
+}
+
+template <class ValueType, class DelegateType>
+void SetResolvedValue(ValueType& ResolvedValue, const ValueType NewValue, DelegateType& OnValueChanged)
+{
+	ZKZ_RETURN_IF(ResolvedValue == NewValue);
+
+	ResolvedValue = NewValue;
+	OnValueChanged.Broadcast(ResolvedValue);
+}
+
+}  // namespace Zkz::MultisourceValueStructPrivate
+
+using namespace Zkz::MultisourceValueStructPrivate;
+
+// -- FZkzMultisourceFloat
+
+FZkzMultisourceFloat::FZkzMultisourceFloat(const EZkzMultisourceResolver InResolver, const float InDefaultValue)
+	: Resolver{InResolver}, DefaultValue{InDefaultValue}, ResolvedValue{ResolveSources(Sources, Resolver, DefaultValue)}
+{
+}
+
+FZkzMultisourceSourceHandle FZkzMultisourceFloat::PushValue(const float Value, const int32 Priority)
+{
+	FZkzMultisourceFloatSource NewSource;
+	NewSource.Priority = Priority;
+	NewSource.PushOrder = ++LastPushOrder;
+	NewSource.Value = Value;
+
+	const FZkzMultisourceSourceHandle Handle = AddSource(Sources, *this, LastSourceId, MoveTemp(NewSource));
+	Resolve();
+	return Handle;
+}
+
+void FZkzMultisourceFloat::PopValue(FZkzMultisourceSourceHandle& Handle)
+{
+	ZKZ_RETURN_IF(!RemoveSource(Sources, *this, Handle));
+	Resolve();
+}
+
+float FZkzMultisourceFloat::GetValue() const
+{
+	return ResolvedValue;
+}
+
+void FZkzMultisourceFloat::SetDefaultValue(const float InDefaultValue)
+{
+	DefaultValue = InDefaultValue;
+	Resolve();
+}
+
+void FZkzMultisourceFloat::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters&)
+{
+	Resolve();
+}
+
+void FZkzMultisourceFloat::PostSerialize(const FArchive&)
+{
+	RestoreLastSourceId(Sources, LastSourceId);
+	RestoreLastPushOrder(Sources, LastPushOrder);
+
+	// Resolved value is transient, so it needs resolving after the default value is loaded
+	ResolvedValue = ResolveSources(Sources, Resolver, DefaultValue);
+}
+
+bool FZkzMultisourceFloat::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+{
+	return FastArrayDeltaSerialize<FZkzMultisourceFloatSource, FZkzMultisourceFloat>(Sources, DeltaParams, *this);
+}
+
+void FZkzMultisourceFloat::Resolve()
+{
+	SetResolvedValue(ResolvedValue, ResolveSources(Sources, Resolver, DefaultValue), OnValueChanged);
+}
+
+// -- FZkzMultisourceInt
+
+FZkzMultisourceInt::FZkzMultisourceInt(const EZkzMultisourceResolver InResolver, const int32 InDefaultValue)
+	: Resolver{InResolver}, DefaultValue{InDefaultValue}, ResolvedValue{ResolveSources(Sources, Resolver, DefaultValue)}
+{
+}
+
+FZkzMultisourceSourceHandle FZkzMultisourceInt::PushValue(const int32 Value, const int32 Priority)
+{
+	FZkzMultisourceIntSource NewSource;
+	NewSource.Priority = Priority;
+	NewSource.PushOrder = ++LastPushOrder;
+	NewSource.Value = Value;
+
+	const FZkzMultisourceSourceHandle Handle = AddSource(Sources, *this, LastSourceId, MoveTemp(NewSource));
+	Resolve();
+	return Handle;
+}
+
+void FZkzMultisourceInt::PopValue(FZkzMultisourceSourceHandle& Handle)
+{
+	ZKZ_RETURN_IF(!RemoveSource(Sources, *this, Handle));
+	Resolve();
+}
+
+int32 FZkzMultisourceInt::GetValue() const
+{
+	return ResolvedValue;
+}
+
+void FZkzMultisourceInt::SetDefaultValue(const int32 InDefaultValue)
+{
+	DefaultValue = InDefaultValue;
+	Resolve();
+}
+
+void FZkzMultisourceInt::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters&)
+{
+	Resolve();
+}
+
+void FZkzMultisourceInt::PostSerialize(const FArchive&)
+{
+	RestoreLastSourceId(Sources, LastSourceId);
+	RestoreLastPushOrder(Sources, LastPushOrder);
+
+	// Resolved value is transient, so it needs resolving after the default value is loaded
+	ResolvedValue = ResolveSources(Sources, Resolver, DefaultValue);
+}
+
+bool FZkzMultisourceInt::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+{
+	return FastArrayDeltaSerialize<FZkzMultisourceIntSource, FZkzMultisourceInt>(Sources, DeltaParams, *this);
+}
+
+void FZkzMultisourceInt::Resolve()
+{
+	SetResolvedValue(ResolvedValue, ResolveSources(Sources, Resolver, DefaultValue), OnValueChanged);
+}
+
+// -- FZkzMultisourceBool
+
+FZkzMultisourceBool::FZkzMultisourceBool(const bool bInDefaultValue)
+	: bDefaultValue{bInDefaultValue}, bResolvedValue{bInDefaultValue}
+{
+}
+
+FZkzMultisourceSourceHandle FZkzMultisourceBool::PushValue()
+{
+	const FZkzMultisourceSourceHandle Handle =
+		AddSource(Sources, *this, LastSourceId, FZkzMultisourceBoolSource{});
+	Resolve();
+	return Handle;
+}
+
+void FZkzMultisourceBool::PopValue(FZkzMultisourceSourceHandle& Handle)
+{
+	ZKZ_RETURN_IF(!RemoveSource(Sources, *this, Handle));
+	Resolve();
+}
+
+bool FZkzMultisourceBool::GetValue() const
+{
+	return bResolvedValue;
+}
+
+void FZkzMultisourceBool::SetDefaultValue(const bool bInDefaultValue)
+{
+	bDefaultValue = bInDefaultValue;
+	Resolve();
+}
+
+void FZkzMultisourceBool::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters&)
+{
+	Resolve();
+}
+
+void FZkzMultisourceBool::PostSerialize(const FArchive&)
+{
+	RestoreLastSourceId(Sources, LastSourceId);
+
+	// Resolved value is transient, so it needs resolving after the default value is loaded
+	bResolvedValue = Sources.IsEmpty() ? bDefaultValue : !bDefaultValue;
+}
+
+bool FZkzMultisourceBool::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+{
+	return FastArrayDeltaSerialize<FZkzMultisourceBoolSource, FZkzMultisourceBool>(Sources, DeltaParams, *this);
+}
+
+void FZkzMultisourceBool::Resolve()
+{
+	SetResolvedValue(bResolvedValue, Sources.IsEmpty() ? bDefaultValue : !bDefaultValue, OnValueChanged);
+}
+
+// -- UZkzMultisourceValueBlueprintFunctionLibrary
+
+FZkzMultisourceSourceHandle UZkzMultisourceValueBlueprintFunctionLibrary::PushFloat(
+	FZkzMultisourceFloat& MultisourceFloat, const float Value, const int32 Priority)
+{
+	return MultisourceFloat.PushValue(Value, Priority);
+}
+
+void UZkzMultisourceValueBlueprintFunctionLibrary::PopFloat(
+	FZkzMultisourceFloat& MultisourceFloat, FZkzMultisourceSourceHandle& Handle)
+{
+	MultisourceFloat.PopValue(Handle);
+}
+
+float UZkzMultisourceValueBlueprintFunctionLibrary::GetFloat(const FZkzMultisourceFloat& MultisourceFloat)
+{
+	return MultisourceFloat.GetValue();
+}
+
+FZkzMultisourceSourceHandle UZkzMultisourceValueBlueprintFunctionLibrary::PushInt(
+	FZkzMultisourceInt& MultisourceInt, const int32 Value, const int32 Priority)
+{
+	return MultisourceInt.PushValue(Value, Priority);
+}
+
+void UZkzMultisourceValueBlueprintFunctionLibrary::PopInt(
+	FZkzMultisourceInt& MultisourceInt, FZkzMultisourceSourceHandle& Handle)
+{
+	MultisourceInt.PopValue(Handle);
+}
+
+int32 UZkzMultisourceValueBlueprintFunctionLibrary::GetInt(const FZkzMultisourceInt& MultisourceInt)
+{
+	return MultisourceInt.GetValue();
+}
+
+FZkzMultisourceSourceHandle UZkzMultisourceValueBlueprintFunctionLibrary::PushBool(
+	FZkzMultisourceBool& MultisourceBool)
+{
+	return MultisourceBool.PushValue();
+}
+
+void UZkzMultisourceValueBlueprintFunctionLibrary::PopBool(
+	FZkzMultisourceBool& MultisourceBool, FZkzMultisourceSourceHandle& Handle)
+{
+	MultisourceBool.PopValue(Handle);
+}
+
+bool UZkzMultisourceValueBlueprintFunctionLibrary::GetBool(const FZkzMultisourceBool& MultisourceBool)
+{
+	return MultisourceBool.GetValue();
+}
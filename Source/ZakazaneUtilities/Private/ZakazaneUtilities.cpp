@@ -2,17 +2,45 @@
 
 #include "ZakazaneUtilities.h"
 
+#include "Zakazane/BinaryLog.h"
+#include "Zakazane/LogStatistics.h"
+
 #define LOCTEXT_NAMESPACE "FZakazaneUtilitiesModule"
 
 void FZakazaneUtilitiesModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+#if !NO_LOGGING
+	GLog->AddOutputDevice(&Zkz::FLogStatistics::Get());
+#endif
+
+#if ZKZ_WITH_BINARY_LOG
+	FString BinaryLogPath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-ZkzBinaryLog="), BinaryLogPath))
+	{
+		Zkz::BinaryLog::Start(BinaryLogPath);
+	}
+	else if (FParse::Param(FCommandLine::Get(), TEXT("ZkzBinaryLog")))
+	{
+		Zkz::BinaryLog::Start();
+	}
+#endif
 }
 
 void FZakazaneUtilitiesModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+#if ZKZ_WITH_BINARY_LOG
+	Zkz::BinaryLog::Stop();
+#endif
+
+#if !NO_LOGGING
+	if (GLog != nullptr)
+	{
+		GLog->RemoveOutputDevice(&Zkz::FLogStatistics::Get());
+	}
+#endif
 }
 
 #undef LOCTEXT_NAMESPACE
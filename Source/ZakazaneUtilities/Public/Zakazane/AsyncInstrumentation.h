@@ -0,0 +1,224 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Async/Future.h"
+#include "Containers/StaticArray.h"
+#include "ReturnIfMacros.h"
+
+/// Opt-in latency instrumentation for promises, futures and their continuations. Compiled in when
+/// ZKZ_WITH_ASYNC_INSTRUMENTATION is set (default in non-shipping builds) and recording only when enabled at runtime
+/// with the Zkz.Async.Instrumentation console variable.
+///
+/// Recorded per tag:
+/// * creation -> fulfilment latency of tagged TScopedPromises and instrumented futures,
+/// * number of cancelled (destroyed unfulfilled) tagged TScopedPromises,
+/// * execution time of instrumented continuations.
+///
+/// Stats are kept as histograms, queried with GetStats, printed with Zkz.Async.DumpStats and cleared with
+/// Zkz.Async.ResetStats. Instrumented
+/// continuations are additionally emitted as timing events on the ZkzAsync trace channel, and the number of pending
+/// tagged promises as a trace counter, to be inspected in Unreal Insights.
+#ifndef ZKZ_WITH_ASYNC_INSTRUMENTATION
+#define ZKZ_WITH_ASYNC_INSTRUMENTATION !UE_BUILD_SHIPPING
+#endif
+
+namespace Zkz::AsyncInstrumentation
+{
+
+#if ZKZ_WITH_ASYNC_INSTRUMENTATION
+
+/// Histogram of durations with logarithmic buckets: bucket N holds durations in [2^N, 2^(N+1)) microseconds (bucket 0
+/// also holds anything shorter).
+struct ZAKAZANEUTILITIES_API FDurationStats
+{
+	static constexpr int32 NumBuckets = 32;
+
+	/// Returns the upper bound of the bucket containing the given percentile, in seconds.
+	double GetPercentileUpperBound(double Percentile) const;
+
+	FString ToString() const;
+
+	TStaticArray<uint64, NumBuckets> Buckets{InPlace, 0};
+
+	uint64 Count = 0;
+
+	double TotalSeconds = 0.0;
+
+	double MaxSeconds = 0.0;
+};
+
+struct FTagStats
+{
+	FDurationStats FulfilmentLatency;
+
+	FDurationStats CancellationLatency;
+
+	FDurationStats ContinuationTime;
+
+	/// Tagged promises and instrumented futures neither fulfilled nor cancelled yet
+	int64 NumPending = 0;
+};
+
+ZAKAZANEUTILITIES_API bool IsEnabled();
+
+ZAKAZANEUTILITIES_API void RecordPending(FName Tag);
+
+ZAKAZANEUTILITIES_API void RecordFulfilment(FName Tag, double LatencySeconds);
+
+ZAKAZANEUTILITIES_API void RecordCancellation(FName Tag, double LatencySeconds);
+
+ZAKAZANEUTILITIES_API void RecordContinuation(FName Tag, double ExecutionSeconds);
+
+/// Returns a snapshot of the stats recorded since the last reset, by tag.
+ZAKAZANEUTILITIES_API TMap<FName, FTagStats> GetStats();
+
+ZAKAZANEUTILITIES_API void DumpStats(FOutputDevice& Output);
+
+ZAKAZANEUTILITIES_API void ResetStats();
+
+/// Measures the execution time of a continuation and emits it as a trace event.
+class ZAKAZANEUTILITIES_API FContinuationScope
+{
+public:
+	explicit FContinuationScope(FName InTag);
+	~FContinuationScope();
+
+	FContinuationScope(const FContinuationScope&) = delete;
+	FContinuationScope& operator=(const FContinuationScope&) = delete;
+
+private:
+	FName Tag;
+
+	double StartTime = 0.0;
+
+	bool bTraceEventStarted = false;
+};
+
+/// Tracks the time from creation to fulfilment or cancellation of a promise. Records nothing until a tag is set.
+class FPromiseTracker
+{
+public:
+	FPromiseTracker() : CreationTime{IsEnabled() ? FPlatformTime::Seconds() : 0.0}
+	{
+	}
+
+	FPromiseTracker(FPromiseTracker&& Other) : Tag{Other.Tag}, CreationTime{Other.CreationTime}
+	{
+		Other.Tag = NAME_None;
+	}
+
+	/// A promise overwritten while still pending is never fulfilled, so it's recorded as cancelled.
+	FPromiseTracker& operator=(FPromiseTracker&& Other)
+	{
+		ZKZ_RETURN_IF(this == &Other, *this);
+
+		OnCancelled();
+
+		Tag = Other.Tag;
+		CreationTime = Other.CreationTime;
+		Other.Tag = NAME_None;
+		return *this;
+	}
+
+	void SetTag(const FName InTag)
+	{
+		if (CreationTime > 0.0 && Tag.IsNone() && !InTag.IsNone())
+		{
+			RecordPending(InTag);
+		}
+
+		Tag = InTag;
+	}
+
+	void OnFulfilled()
+	{
+		if (CreationTime > 0.0 && !Tag.IsNone())
+		{
+			RecordFulfilment(Tag, FPlatformTime::Seconds() - CreationTime);
+			Tag = NAME_None;
+		}
+	}
+
+	void OnCancelled()
+	{
+		if (CreationTime > 0.0 && !Tag.IsNone())
+		{
+			RecordCancellation(Tag, FPlatformTime::Seconds() - CreationTime);
+			Tag = NAME_None;
+		}
+	}
+
+private:
+	FName Tag;
+
+	/// Zero when instrumentation was disabled at creation
+	double CreationTime = 0.0;
+};
+
+#else
+
+inline bool IsEnabled()
+{
+	return false;
+}
+
+class FPromiseTracker
+{
+public:
+	void SetTag(FName)
+	{
+	}
+
+	void OnFulfilled()
+	{
+	}
+
+	void OnCancelled()
+	{
+	}
+};
+
+#endif
+
+/// Wraps the continuation so that its execution time is recorded under the given tag. E.g.:
+/// @code
+/// Future.Next(InstrumentContinuation("PathQuery", [](FPath Path) { ... }));
+/// @endcode
+/// Returns the continuation unchanged if instrumentation isn't compiled in.
+template <class FuncType>
+auto InstrumentContinuation(const FName Tag, FuncType&& Func)
+{
+#if ZKZ_WITH_ASYNC_INSTRUMENTATION
+	return [Tag, Func = Forward<FuncType>(Func)]<class... ArgTypes>(ArgTypes&&... Args) mutable -> decltype(auto)
+	{
+		const FContinuationScope Scope{Tag};
+		return ::Invoke(Func, Forward<ArgTypes>(Args)...);
+	};
+#else
+	return Forward<FuncType>(Func);
+#endif
+}
+
+/// Records the time from now until the future is fulfilled under the given tag. Returns a future of the same value.
+template <class T>
+TFuture<T> InstrumentFuture(const FName Tag, TFuture<T>&& Future)
+{
+#if ZKZ_WITH_ASYNC_INSTRUMENTATION
+	ZKZ_RETURN_IF(!IsEnabled() || Future.IsReady(), MoveTemp(Future));
+
+	RecordPending(Tag);
+	return Future.Next(
+		[Tag, StartTime = FPlatformTime::Seconds()]<class ResultType>(ResultType&& Result) -> T
+		{
+			RecordFulfilment(Tag, FPlatformTime::Seconds() - StartTime);
+			return Forward<ResultType>(Result);
+		});
+#else
+	return MoveTemp(Future);
+#endif
+}
+
+}  // namespace Zkz::AsyncInstrumentation
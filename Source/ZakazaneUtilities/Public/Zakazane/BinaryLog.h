@@ -0,0 +1,146 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+#ifndef ZKZ_WITH_BINARY_LOG
+#define ZKZ_WITH_BINARY_LOG !NO_LOGGING
+#endif
+
+/// Binary log sink: records log messages as compact binary entries (timestamp, category, verbosity, format string id
+/// and the raw format arguments) rather than formatting them. Entries go to a per-thread lock-free ring buffer and a
+/// background thread writes them to a file, which is turned back to text offline, @see Zkz::BinaryLog::Decode and the
+/// ZkzDecodeBinaryLog commandlet. Recording a message costs a few hundred nanoseconds, no matter if the text log is
+/// enabled for the category or not, which makes detailed logs affordable in production builds.
+///
+/// Zkz::LogToScreenAndConsole and Zkz::LogUserError (and their formatting variants) record to the binary log while it's
+/// recording. Recording is started with -ZkzBinaryLog[=Path] on the command line or the Zkz.Log.Binary.Start console
+/// command. When a thread's buffer is full, its entries are dropped (and counted) rather than blocking.
+namespace Zkz::BinaryLog
+{
+
+/// Starts recording to the given file, or to Saved/Logs/<Project>.zkzlog if empty. Restarts if already recording.
+ZAKAZANEUTILITIES_API bool Start(const FString& FilePath = FString{});
+
+/// Writes all recorded entries and stops recording.
+ZAKAZANEUTILITIES_API void Stop();
+
+/// Writes all entries recorded so far, blocking until they're written.
+ZAKAZANEUTILITIES_API void Flush();
+
+/// Number of entries dropped since the recording started, as their thread's buffer was full.
+ZAKAZANEUTILITIES_API int64 GetNumDropped();
+
+/// Decodes a binary log file content to text, one line per entry. Returns false if the data isn't a binary log,
+/// decoding what it can if it's only truncated (e.g. the process crashed while writing it).
+ZAKAZANEUTILITIES_API bool Decode(TConstArrayView<uint8> Data, FString& OutText);
+
+namespace Private
+{
+
+extern ZAKAZANEUTILITIES_API std::atomic<bool> bRecording;
+
+enum class EArgType : uint8
+{
+	Int64,
+	UInt64,
+	Double,
+	String,
+	AnsiString,
+	Pointer,
+};
+
+/// Size of the fixed part of an entry: size, timestamp, category id, verbosity, format id and number of args
+inline constexpr int32 EntryHeaderSize = sizeof(uint32) + sizeof(uint64) + sizeof(uint32) + sizeof(uint8)
+	+ sizeof(uint32) + sizeof(uint8);
+
+/// Copies the entry into the buffer of the calling thread, interning the category and format
+ZAKAZANEUTILITIES_API void Write(FName Category, const TCHAR* Format, TArray<uint8, TInlineAllocator<256>>& Entry);
+
+template <class T>
+void AppendRaw(TArray<uint8, TInlineAllocator<256>>& Entry, const T& Value)
+{
+	Entry.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+}
+
+template <class CharType>
+void AppendString(TArray<uint8, TInlineAllocator<256>>& Entry, const EArgType Type, const CharType* String)
+{
+	const uint32 Len = String != nullptr ? TCString<CharType>::Strlen(String) : 0;
+	AppendRaw(Entry, Type);
+	AppendRaw(Entry, Len);
+	Entry.Append(reinterpret_cast<const uint8*>(String), Len * sizeof(CharType));
+}
+
+template <class T>
+void AppendArg(TArray<uint8, TInlineAllocator<256>>& Entry, const T& Arg)
+{
+	using ArgType = std::decay_t<T>;
+	if constexpr (std::is_same_v<ArgType, TCHAR*> || std::is_same_v<ArgType, const TCHAR*>)
+	{
+		AppendString(Entry, EArgType::String, Arg);
+	}
+	else if constexpr (std::is_same_v<ArgType, ANSICHAR*> || std::is_same_v<ArgType, const ANSICHAR*>)
+	{
+		AppendString(Entry, EArgType::AnsiString, Arg);
+	}
+	else if constexpr (std::is_pointer_v<ArgType>)
+	{
+		AppendRaw(Entry, EArgType::Pointer);
+		AppendRaw(Entry, static_cast<uint64>(reinterpret_cast<UPTRINT>(Arg)));
+	}
+	else if constexpr (std::is_floating_point_v<ArgType>)
+	{
+		AppendRaw(Entry, EArgType::Double);
+		AppendRaw(Entry, static_cast<double>(Arg));
+	}
+	else if constexpr (std::is_enum_v<ArgType>)
+	{
+		AppendArg(Entry, static_cast<std::underlying_type_t<ArgType>>(Arg));
+	}
+	else if constexpr (std::is_unsigned_v<ArgType>)
+	{
+		AppendRaw(Entry, EArgType::UInt64);
+		AppendRaw(Entry, static_cast<uint64>(Arg));
+	}
+	else
+	{
+		static_assert(std::is_integral_v<ArgType>, "Unsupported binary log argument type");
+		AppendRaw(Entry, EArgType::Int64);
+		AppendRaw(Entry, static_cast<int64>(Arg));
+	}
+}
+
+}  // namespace Private
+
+inline bool IsRecording()
+{
+	return Private::bRecording.load(std::memory_order_relaxed);
+}
+
+/// Records a message to the binary log, if it's recording. Format has to be a string literal, it's identified by its
+/// address. Arguments are recorded as they are, the same as they'd be passed to FString::Printf.
+template <class... ArgTypes>
+void Record(const FName Category, const ELogVerbosity::Type Verbosity, const TCHAR* Format, const ArgTypes&... Args)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	static_assert(sizeof...(ArgTypes) <= MAX_uint8, "Too many binary log arguments");
+
+	// Size, category and format ids are filled in by Write
+	TArray<uint8, TInlineAllocator<256>> Entry;
+	Entry.SetNumZeroed(Private::EntryHeaderSize);
+	Entry[sizeof(uint32) + sizeof(uint64) + sizeof(uint32)] = static_cast<uint8>(Verbosity);
+	Entry[Private::EntryHeaderSize - 1] = static_cast<uint8>(sizeof...(ArgTypes));
+	(Private::AppendArg(Entry, Args), ...);
+
+	Private::Write(Category, Format, Entry);
+}
+
+}  // namespace Zkz::BinaryLog
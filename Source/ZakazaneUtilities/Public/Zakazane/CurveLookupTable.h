@@ -0,0 +1,67 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UCurveFloat;
+struct FRichCurve;
+
+namespace Zkz
+{
+
+/// Float curve baked into uniformly spaced samples, evaluated with a single array lookup and a linear interpolation,
+/// rather than searching the rich curve keys and evaluating their tangents.
+class ZAKAZANEUTILITIES_API FCurveLookupTable
+{
+public:
+	static constexpr int32 DefaultNumSamples = 128;
+
+	FCurveLookupTable() = default;
+
+	/// Samples the whole time range of the curve. Curves with no keys bake to a constant table of their default value.
+	explicit FCurveLookupTable(const FRichCurve& Curve, int32 NumSamples = DefaultNumSamples);
+
+	/// Returns the table baked from the curve asset, shared with everyone else using the same curve. The table is
+	/// baked on the first request and freed once nobody references it. In the editor, rebaked when requested after the
+	/// curve was edited, tables baked before stay valid but keep the old shape. Thread safe.
+	static TSharedRef<const FCurveLookupTable> GetShared(const UCurveFloat& Curve);
+
+	/// Hash of everything the baked samples depend on - the keys and the default value
+	static uint32 HashCurve(const FRichCurve& Curve);
+
+	/// Returns false if the curve was edited since the table was baked from it (or it's another curve).
+	bool IsBakedFrom(const FRichCurve& Curve) const;
+
+	/// Evaluates the curve at the given time, clamped to the time range of the curve.
+	float Evaluate(float Time) const;
+
+	/// Evaluates the curve at the given fraction of its time range, clamped to [0, 1].
+	float EvaluateNormalized(float Alpha) const;
+
+	float GetMinTime() const
+	{
+		return MinTime;
+	}
+
+	float GetMaxTime() const
+	{
+		return MaxTime;
+	}
+
+	int32 GetNumSamples() const
+	{
+		return Samples.Num();
+	}
+
+private:
+	TArray<float> Samples;
+
+	float MinTime = 0.0f;
+
+	float MaxTime = 0.0f;
+
+	uint32 CurveHash = 0;
+};
+
+}  // namespace Zkz
@@ -5,41 +5,72 @@
 #include "CoreMinimal.h"
 
 #include "Async/Future.h"
+#include "AsyncInstrumentation.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/TVariant.h"
 #include "ReturnIfMacros.h"
+#include "TimerWheel.h"
+
+#include <atomic>
 
 namespace Zkz
 {
 
 // #TODO #Promise: Review usages of TPromise and potentially replace with TScopedPromise
 /// Wrapper for TPromise gracefully handling destruction prior to being fulfilled. In case this happens it sets the
-/// promise value to the result of the CancelledValueFunc function passed to the constructor.
+/// promise value to the cancelled value passed to the constructor - either a plain value or the result of a
+/// CancelledValueFunc function. Prefer the plain value where possible, as it doesn't need to allocate a TFunction.
+/// Promises given an instrumentation tag report their latency and cancellations. @see AsyncInstrumentation
 template <class T UE_REQUIRES(!std::is_void_v<T>)>
 class TScopedPromise
 {
 public:
-	explicit TScopedPromise(TFunction<T()> InCancelledValueFunc) : CancelledValueFunc{MoveTemp(InCancelledValueFunc)}
+	explicit TScopedPromise(TFunction<T()> InCancelledValueFunc)
+		: CancelledValue{TInPlaceType<TFunction<T()>>{}, MoveTemp(InCancelledValueFunc)}
+	{
+	}
+
+	/// Takes anything the cancelled value can be constructed from, other than functions returning it
+	template <
+		class ArgType UE_REQUIRES(std::is_constructible_v<T, ArgType> && !std::is_invocable_r_v<T, ArgType>)>
+	explicit TScopedPromise(ArgType&& InCancelledValue)
+		: CancelledValue{TInPlaceType<T>{}, Forward<ArgType>(InCancelledValue)}
 	{
 	}
 
 	TScopedPromise(TUniqueFunction<void()>&& CompletionCallback, TFunction<T()> InCancelledValueFunc)
-		: Promise{MoveTemp(CompletionCallback)}, CancelledValueFunc{MoveTemp(InCancelledValueFunc)}
+		: Promise{MoveTemp(CompletionCallback)}
+		, CancelledValue{TInPlaceType<TFunction<T()>>{}, MoveTemp(InCancelledValueFunc)}
+	{
+	}
+
+	template <
+		class ArgType UE_REQUIRES(std::is_constructible_v<T, ArgType> && !std::is_invocable_r_v<T, ArgType>)>
+	TScopedPromise(TUniqueFunction<void()>&& CompletionCallback, ArgType&& InCancelledValue)
+		: Promise{MoveTemp(CompletionCallback)}
+		, CancelledValue{TInPlaceType<T>{}, Forward<ArgType>(InCancelledValue)}
 	{
 	}
 
 	TScopedPromise(TScopedPromise&& Other)
 		: Promise{MoveTemp(Other.Promise)}
-		, CancelledValueFunc{MoveTemp(Other.CancelledValueFunc)}
+		, CancelledValue{MoveTemp(Other.CancelledValue)}
+		, Tracker{MoveTemp(Other.Tracker)}
 		, bFulfilled{MoveTemp(Other.bFulfilled)}
 	{
 		Other.bFulfilled = true;
 	}
 
+	/// The overwritten promise is cancelled, the same as if it was destroyed
 	TScopedPromise& operator=(TScopedPromise&& Other)
 	{
 		ZKZ_RETURN_IF(this == &Other, *this);
 
+		CancelIfUnfulfilled();
+
 		Promise = MoveTemp(Other.Promise);
-		CancelledValueFunc = MoveTemp(Other.CancelledValueFunc);
+		CancelledValue = MoveTemp(Other.CancelledValue);
+		Tracker = MoveTemp(Other.Tracker);
 		bFulfilled = Other.bFulfilled;
 
 		Other.bFulfilled = true;
@@ -48,17 +79,14 @@ public:
 
 	~TScopedPromise()
 	{
-		// #TODO #Promise: Should have IsFulfilled in TPromise (push request)
-		if (!bFulfilled)
-		{
-			SetValue(CancelledValueFunc());
-		}
+		CancelIfUnfulfilled();
 	}
 
 	template <class... ArgTypes>
 	void EmplaceValue(ArgTypes&&... Args)
 	{
 		bFulfilled = true;
+		Tracker.OnFulfilled();
 		Promise.EmplaceValue(Forward<ArgTypes>(Args)...);
 	}
 
@@ -66,6 +94,7 @@ public:
 	void SetValue(ArgTypes&&... Args)
 	{
 		bFulfilled = true;
+		Tracker.OnFulfilled();
 		Promise.SetValue(Forward<ArgTypes>(Args)...);
 	}
 
@@ -74,10 +103,36 @@ public:
 		return Promise.GetFuture();
 	}
 
+	/// Records the time from construction until fulfilment (or cancellation) under the given tag, if async
+	/// instrumentation is enabled.
+	void SetInstrumentationTag(const FName Tag)
+	{
+		Tracker.SetTag(Tag);
+	}
+
 private:
+	void CancelIfUnfulfilled()
+	{
+		// #TODO #Promise: Should have IsFulfilled in TPromise (push request)
+		ZKZ_RETURN_IF(bFulfilled);
+
+		Tracker.OnCancelled();
+
+		if (const TFunction<T()>* const CancelledValueFunc = CancelledValue.template TryGet<TFunction<T()>>())
+		{
+			SetValue((*CancelledValueFunc)());
+		}
+		else
+		{
+			SetValue(MoveTemp(CancelledValue.template Get<T>()));
+		}
+	}
+
 	TPromise<T> Promise;
 
-	TFunction<T()> CancelledValueFunc;
+	TVariant<TFunction<T()>, T> CancelledValue;
+
+	AsyncInstrumentation::FPromiseTracker Tracker;
 
 	bool bFulfilled = false;
 };
@@ -151,4 +206,347 @@ auto AggregateFutures(TArray<TFuture<FutureType>> Futures, ResultType&& Initial,
 	return AggregatedFuture;
 }
 
+/// Instrumented variant of AggregateFutures. Records the time until the aggregated future is fulfilled and the
+/// execution time of each AggregateFunc call under the given tag. @see AsyncInstrumentation
+template <class FutureType, class ResultType, class AggregateFuncType>
+auto AggregateFutures(
+	const FName InstrumentationTag,
+	TArray<TFuture<FutureType>> Futures,
+	ResultType&& Initial,
+	AggregateFuncType&& AggregateFunc)
+{
+	return AsyncInstrumentation::InstrumentFuture(
+		InstrumentationTag,
+		AggregateFutures(
+			MoveTemp(Futures),
+			Forward<ResultType>(Initial),
+			AsyncInstrumentation::InstrumentContinuation(
+				InstrumentationTag, Forward<AggregateFuncType>(AggregateFunc))));
+}
+
+namespace FutureTimeoutPrivate
+{
+
+template <class T>
+struct TTimeoutEntry
+{
+	bool TrySettle()
+	{
+		return !bSettled.exchange(true);
+	}
+
+	TPromise<T> Promise;
+
+	std::atomic<bool> bSettled = false;
+};
+
+template <class T, class FallbackFuncType>
+struct TTimeoutState
+{
+	explicit TTimeoutState(const int32 NumEntries, FallbackFuncType&& InFallbackFunc)
+		: FallbackFunc{MoveTemp(InFallbackFunc)}
+	{
+		Entries.SetNum(NumEntries);
+	}
+
+	TArray<TTimeoutEntry<T>> Entries;
+
+	FallbackFuncType FallbackFunc;
+};
+
+}  // namespace FutureTimeoutPrivate
+
+/// Returns futures fulfilled with either the values of the given futures or - for the ones not fulfilled within
+/// Timeout seconds - with the result of FallbackFunc (taking no arguments). All the futures share a single timer in
+/// the given timer wheel, or the shared one if null (@see FSharedTimerWheel), so the timeout is quantized to the
+/// wheel's tick and fallback values are set by whoever advances the wheel (the game thread for the shared one).
+/// Pending timeouts cost close to nothing until they expire.
+///
+/// A given (not shared) timer wheel isn't thread safe, it's up to the caller to schedule and advance it on a single
+/// thread.
+template <class T, class FallbackFuncType>
+TArray<TFuture<T>> WithTimeout(
+	TArray<TFuture<T>> Futures,
+	const double Timeout,
+	FallbackFuncType&& FallbackFunc,
+	FTimerWheel* const TimerWheel = nullptr)
+{
+	using namespace FutureTimeoutPrivate;
+
+	using StateType = TTimeoutState<T, std::decay_t<FallbackFuncType>>;
+
+	const TSharedRef<StateType, ESPMode::ThreadSafe> State = MakeShared<StateType, ESPMode::ThreadSafe>(
+		Futures.Num(), std::decay_t<FallbackFuncType>{Forward<FallbackFuncType>(FallbackFunc)});
+
+	TArray<TFuture<T>> Results;
+	Results.Reserve(Futures.Num());
+
+	bool bAllReady = true;
+	for (int32 Idx = 0; Idx < Futures.Num(); ++Idx)
+	{
+		Results.Emplace(State->Entries[Idx].Promise.GetFuture());
+		bAllReady &= Futures[Idx].IsReady();
+
+		Futures[Idx].Next(
+			[State, Idx]<class FutureResultType>(FutureResultType&& Result)
+			{
+				TTimeoutEntry<T>& Entry = State->Entries[Idx];
+				if (Entry.TrySettle())
+				{
+					Entry.Promise.SetValue(Forward<FutureResultType>(Result));
+				}
+			});
+	}
+
+	if (!bAllReady)
+	{
+		FTimerWheel::FCallback SettleWithFallback = [State]
+		{
+			for (TTimeoutEntry<T>& Entry : State->Entries)
+			{
+				if (Entry.TrySettle())
+				{
+					Entry.Promise.SetValue(::Invoke(State->FallbackFunc));
+				}
+			}
+		};
+
+		if (TimerWheel != nullptr)
+		{
+			TimerWheel->Schedule(Timeout, MoveTemp(SettleWithFallback));
+		}
+		else
+		{
+			FSharedTimerWheel::Get().Schedule(Timeout, MoveTemp(SettleWithFallback));
+		}
+	}
+
+	return Results;
+}
+
+/// Returns a future fulfilled with either the value of the given future or, if it isn't fulfilled within Timeout
+/// seconds, with the result of FallbackFunc (taking no arguments).
+/// @see WithTimeout(TArray<TFuture<T>> Futures, double Timeout, FallbackFuncType&& FallbackFunc, FTimerWheel*)
+template <class T, class FallbackFuncType>
+TFuture<T> WithTimeout(
+	TFuture<T> Future, const double Timeout, FallbackFuncType&& FallbackFunc, FTimerWheel* const TimerWheel = nullptr)
+{
+	ZKZ_RETURN_IF(Future.IsReady(), MoveTemp(Future));
+
+	TArray<TFuture<T>> Futures;
+	Futures.Emplace(MoveTemp(Future));
+
+	return MoveTemp(WithTimeout(MoveTemp(Futures), Timeout, Forward<FallbackFuncType>(FallbackFunc), TimerWheel)[0]);
+}
+
+/// Same as WithTimeout, but takes an absolute deadline, in FPlatformTime::Seconds.
+template <class T, class FallbackFuncType>
+TArray<TFuture<T>> WithDeadline(
+	TArray<TFuture<T>> Futures,
+	const double Deadline,
+	FallbackFuncType&& FallbackFunc,
+	FTimerWheel* const TimerWheel = nullptr)
+{
+	return WithTimeout(
+		MoveTemp(Futures), Deadline - FPlatformTime::Seconds(), Forward<FallbackFuncType>(FallbackFunc), TimerWheel);
+}
+
+/// Same as WithTimeout, but takes an absolute deadline, in FPlatformTime::Seconds.
+template <class T, class FallbackFuncType>
+TFuture<T> WithDeadline(
+	TFuture<T> Future, const double Deadline, FallbackFuncType&& FallbackFunc, FTimerWheel* const TimerWheel = nullptr)
+{
+	return WithTimeout(
+		MoveTemp(Future), Deadline - FPlatformTime::Seconds(), Forward<FallbackFuncType>(FallbackFunc), TimerWheel);
+}
+
+/// AggregateFutures variant bounding the time waited for the futures. Futures not fulfilled within Timeout seconds are
+/// aggregated with the result of FallbackFunc instead. A single timer is used for all the futures.
+/// @see AggregateFutures, WithTimeout
+template <class FutureType, class FallbackFuncType, class ResultType, class AggregateFuncType>
+auto AggregateFuturesWithTimeout(
+	TArray<TFuture<FutureType>> Futures,
+	const double Timeout,
+	FallbackFuncType&& FallbackFunc,
+	ResultType&& Initial,
+	AggregateFuncType&& AggregateFunc,
+	FTimerWheel* const TimerWheel = nullptr)
+{
+	return AggregateFutures(
+		WithTimeout(MoveTemp(Futures), Timeout, Forward<FallbackFuncType>(FallbackFunc), TimerWheel),
+		Forward<ResultType>(Initial),
+		Forward<AggregateFuncType>(AggregateFunc));
+}
+
+/// Same as AggregateFuturesWithTimeout, but takes an absolute deadline, in FPlatformTime::Seconds.
+template <class FutureType, class FallbackFuncType, class ResultType, class AggregateFuncType>
+auto AggregateFuturesWithDeadline(
+	TArray<TFuture<FutureType>> Futures,
+	const double Deadline,
+	FallbackFuncType&& FallbackFunc,
+	ResultType&& Initial,
+	AggregateFuncType&& AggregateFunc,
+	FTimerWheel* const TimerWheel = nullptr)
+{
+	return AggregateFuturesWithTimeout(
+		MoveTemp(Futures),
+		Deadline - FPlatformTime::Seconds(),
+		Forward<FallbackFuncType>(FallbackFunc),
+		Forward<ResultType>(Initial),
+		Forward<AggregateFuncType>(AggregateFunc),
+		TimerWheel);
+}
+
+namespace AsyncTransformPrivate
+{
+
+template <class T>
+struct TFutureResultType;
+
+template <class T>
+struct TFutureResultType<TFuture<T>>
+{
+	using Type = T;
+};
+
+template <class InputType, class ResultType, class FuncType>
+struct TAsyncTransformState
+{
+	TAsyncTransformState(TArray<InputType>&& InInputs, FuncType&& InFunc)
+		: Inputs{MoveTemp(InInputs)}, Func{MoveTemp(InFunc)}
+	{
+		Results.SetNum(Inputs.Num());
+	}
+
+	void Fulfil()
+	{
+		TArray<ResultType> FinalResults;
+		FinalResults.Reserve(Results.Num());
+		for (TOptional<ResultType>& Result : Results)
+		{
+			FinalResults.Emplace(MoveTemp(Result.GetValue()));
+		}
+
+		Results.Empty();
+		Promise.SetValue(MoveTemp(FinalResults));
+	}
+
+	TArray<InputType> Inputs;
+	FuncType Func;
+
+	TArray<TOptional<ResultType>> Results;
+	TPromise<TArray<ResultType>> Promise;
+
+	FCriticalSection CriticalSection;
+
+	// All below guarded by CriticalSection
+	int32 NextInputIdx = 0;
+	int32 NumCompleted = 0;
+	int32 NumPendingLaunches = 0;
+	bool bLaunching = false;
+};
+
+/// Requests NumLaunches more jobs to be started. Only one thread at a time runs the launch loop - others just bump the
+/// number of pending launches. This way Func is never invoked concurrently and futures completing synchronously
+/// (within Func) don't recurse into another launch but get picked up by the loop.
+template <class StateType>
+void RequestAsyncTransformLaunches(const TSharedRef<StateType, ESPMode::ThreadSafe>& State, const int32 NumLaunches)
+{
+	{
+		FScopeLock Lock{&State->CriticalSection};
+		State->NumPendingLaunches += NumLaunches;
+		ZKZ_RETURN_IF(State->bLaunching);
+		State->bLaunching = true;
+	}
+
+	while (true)
+	{
+		int32 InputIdx = INDEX_NONE;
+
+		{
+			FScopeLock Lock{&State->CriticalSection};
+			if (State->NumPendingLaunches == 0 || State->NextInputIdx == State->Inputs.Num())
+			{
+				State->NumPendingLaunches = 0;
+				State->bLaunching = false;
+				return;
+			}
+
+			--State->NumPendingLaunches;
+			InputIdx = State->NextInputIdx++;
+		}
+
+		::Invoke(State->Func, AsConst(State->Inputs[InputIdx]))
+			.Next(
+				[State, InputIdx]<class FutureResultType>(FutureResultType&& FutureResult)
+				{
+					// Each job writes to its own slot and Results isn't resized until all jobs are done
+					State->Results[InputIdx].Emplace(Forward<FutureResultType>(FutureResult));
+
+					bool bAllCompleted = false;
+					{
+						FScopeLock Lock{&State->CriticalSection};
+						bAllCompleted = ++State->NumCompleted == State->Inputs.Num();
+					}
+
+					if (bAllCompleted)
+					{
+						State->Fulfil();
+					}
+					else
+					{
+						RequestAsyncTransformLaunches(State, 1);
+					}
+				});
+	}
+}
+
+}  // namespace AsyncTransformPrivate
+
+/// Maps each of the Inputs to a future using Func, keeping at most MaxInFlight of the returned futures unfulfilled at
+/// a time. Next input is passed to Func as soon as any of the in-flight futures is fulfilled. Returns a future of all
+/// results, given in the order of Inputs.
+/// Func takes a const reference to an input and returns a TFuture. It's never invoked concurrently, but may be invoked
+/// from whichever thread fulfils the previous future.
+template <class InputType, class FuncType>
+auto AsyncTransform(TArray<InputType> Inputs, const int32 MaxInFlight, FuncType&& Func)
+{
+	using namespace AsyncTransformPrivate;
+
+	using DecayedFuncType = std::decay_t<FuncType>;
+	using ResultType = typename TFutureResultType<std::invoke_result_t<DecayedFuncType&, const InputType&>>::Type;
+	using StateType = TAsyncTransformState<InputType, ResultType, DecayedFuncType>;
+
+	ensureMsgf(MaxInFlight > 0, TEXT("AsyncTransform needs to allow at least one job in flight"));
+
+	const int32 NumInputs = Inputs.Num();
+	const TSharedRef<StateType, ESPMode::ThreadSafe> State = MakeShared<StateType, ESPMode::ThreadSafe>(
+		MoveTemp(Inputs), DecayedFuncType{Forward<FuncType>(Func)});
+
+	TFuture<TArray<ResultType>> Result = State->Promise.GetFuture();
+
+	if (NumInputs == 0)
+	{
+		State->Promise.SetValue(TArray<ResultType>{});
+		return Result;
+	}
+
+	RequestAsyncTransformLaunches(State, FMath::Clamp(MaxInFlight, 1, NumInputs));
+	return Result;
+}
+
+/// Instrumented variant of AsyncTransform. Records the time until all results are ready and the execution time of
+/// each Func call under the given tag. @see AsyncInstrumentation
+template <class InputType, class FuncType>
+auto AsyncTransform(
+	const FName InstrumentationTag, TArray<InputType> Inputs, const int32 MaxInFlight, FuncType&& Func)
+{
+	return AsyncInstrumentation::InstrumentFuture(
+		InstrumentationTag,
+		AsyncTransform(
+			MoveTemp(Inputs),
+			MaxInFlight,
+			AsyncInstrumentation::InstrumentContinuation(InstrumentationTag, Forward<FuncType>(Func))));
+}
+
 }  // namespace Zkz
@@ -0,0 +1,187 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "ReturnIfMacros.h"
+
+namespace Zkz
+{
+
+/// Handle to a value stored in TGenerationalSlots: slot index plus the generation of the slot at the time the value
+/// was added. Default constructed handle is never valid.
+struct FGenerationalHandle
+{
+	int32 Index = INDEX_NONE;
+
+	uint32 Generation = 0;
+
+	bool IsSet() const
+	{
+		return Index != INDEX_NONE;
+	}
+
+	bool operator==(const FGenerationalHandle&) const = default;
+
+	friend uint32 GetTypeHash(const FGenerationalHandle& Handle)
+	{
+		return HashCombineFast(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Generation));
+	}
+};
+
+/// Slot array handing out generational handles to the stored values. Add, Remove and Find are O(1) with no hashing.
+/// Removed slots are reused (free list), and their generation is bumped on every removal, so stale handles - of
+/// removed values, possibly with their slot reused since - are safely detected rather than aliasing a newer value.
+template <class T>
+class TGenerationalSlots
+{
+public:
+	FGenerationalHandle Add(T Value)
+	{
+		int32 Index = INDEX_NONE;
+		if (FreeIndices.IsEmpty())
+		{
+			Index = Slots.AddDefaulted();
+		}
+		else
+		{
+			Index = FreeIndices.Pop(EAllowShrinking::No);
+		}
+
+		FSlot& Slot = Slots[Index];
+		Slot.Value.Emplace(MoveTemp(Value));
+		++NumValues;
+
+		return FGenerationalHandle{Index, Slot.Generation};
+	}
+
+	/// Returns false if the handle is stale or was never valid.
+	bool Remove(const FGenerationalHandle Handle)
+	{
+		ZKZ_RETURN_IF(!IsValid(Handle), false);
+
+		FSlot& Slot = Slots[Handle.Index];
+		Slot.Value.Reset();
+		++Slot.Generation;
+		--NumValues;
+
+		FreeIndices.Emplace(Handle.Index);
+		return true;
+	}
+
+	/// Removes the value, moving it out to OutValue. Returns false if the handle is stale or was never valid.
+	bool RemoveAndCopyValue(const FGenerationalHandle Handle, T& OutValue)
+	{
+		ZKZ_RETURN_IF(!IsValid(Handle), false);
+
+		OutValue = MoveTemp(*Slots[Handle.Index].Value);
+		return Remove(Handle);
+	}
+
+	bool IsValid(const FGenerationalHandle Handle) const
+	{
+		return Slots.IsValidIndex(Handle.Index) && Slots[Handle.Index].Generation == Handle.Generation
+			&& Slots[Handle.Index].Value.IsSet();
+	}
+
+	/// Returns the handle of the value currently stored at the given index, or an unset handle if there's none.
+	FGenerationalHandle GetHandle(const int32 Index) const
+	{
+		ZKZ_RETURN_IF(!Slots.IsValidIndex(Index) || !Slots[Index].Value.IsSet(), FGenerationalHandle{});
+		return FGenerationalHandle{Index, Slots[Index].Generation};
+	}
+
+	T* Find(const FGenerationalHandle Handle)
+	{
+		return IsValid(Handle) ? &*Slots[Handle.Index].Value : nullptr;
+	}
+
+	const T* Find(const FGenerationalHandle Handle) const
+	{
+		return IsValid(Handle) ? &*Slots[Handle.Index].Value : nullptr;
+	}
+
+	T& operator[](const FGenerationalHandle Handle)
+	{
+		check(IsValid(Handle));
+		return *Slots[Handle.Index].Value;
+	}
+
+	const T& operator[](const FGenerationalHandle Handle) const
+	{
+		check(IsValid(Handle));
+		return *Slots[Handle.Index].Value;
+	}
+
+	int32 Num() const
+	{
+		return NumValues;
+	}
+
+	bool IsEmpty() const
+	{
+		return NumValues == 0;
+	}
+
+	/// Calls Func(const FGenerationalHandle, T&) for each stored value, in slot order.
+	template <class FuncType>
+	void ForEach(FuncType&& Func)
+	{
+		for (int32 Index = 0; Index < Slots.Num(); ++Index)
+		{
+			if (Slots[Index].Value.IsSet())
+			{
+				::Invoke(Func, FGenerationalHandle{Index, Slots[Index].Generation}, *Slots[Index].Value);
+			}
+		}
+	}
+
+	/// Calls Func(const FGenerationalHandle, const T&) for each stored value, in slot order.
+	template <class FuncType>
+	void ForEach(FuncType&& Func) const
+	{
+		for (int32 Index = 0; Index < Slots.Num(); ++Index)
+		{
+			if (Slots[Index].Value.IsSet())
+			{
+				::Invoke(Func, FGenerationalHandle{Index, Slots[Index].Generation}, AsConst(*Slots[Index].Value));
+			}
+		}
+	}
+
+	/// Removes all values. Generations are kept, so handles handed out so far stay invalid.
+	void Reset()
+	{
+		FreeIndices.Reset();
+		for (int32 Index = Slots.Num() - 1; Index >= 0; --Index)
+		{
+			if (Slots[Index].Value.IsSet())
+			{
+				Slots[Index].Value.Reset();
+				++Slots[Index].Generation;
+			}
+
+			FreeIndices.Emplace(Index);
+		}
+
+		NumValues = 0;
+	}
+
+private:
+	struct FSlot
+	{
+		TOptional<T> Value;
+
+		/// Starts at 1, so that default constructed handles are never valid
+		uint32 Generation = 1;
+	};
+
+	TArray<FSlot> Slots;
+
+	TArray<int32> FreeIndices;
+
+	int32 NumValues = 0;
+};
+
+}  // namespace Zkz
@@ -4,10 +4,13 @@
 
 #include "CoreMinimal.h"
 
+#include "CurveLookupTable.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 
 #include "InterpolatedValue.generated.h"
 
+class UCurveFloat;
+
 USTRUCT(BlueprintType)
 struct ZAKAZANEUTILITIES_API FZkzInterpolatedFloatValue
 {
@@ -21,6 +24,7 @@ struct ZAKAZANEUTILITIES_API FZkzInterpolatedFloatValue
 
 	void Reset(float InValue);
 
+	/// Moves towards the target frame-rate independently, @see Zkz::Interpolation::TExponentialPolicy
 	void Update(float DeltaTime);
 
 	float GetCurrent() const;
@@ -33,6 +37,19 @@ struct ZAKAZANEUTILITIES_API FZkzInterpolatedFloatValue
 
 	void SetInterpSpeed(float InInterpSpeed);
 
+	/// True when Current reached Target. Settled values skip Update until given a new target - any target, even the
+	/// current value, which then settles (and broadcasts OnArrived) on the next Update, same as TInterpolatedValue.
+	bool IsSettled() const;
+
+	/// Returns the value it would have after updating by Time, without updating it
+	float PredictValue(float Time) const;
+
+	/// Returns the time after which the value stays within Tolerance of its target
+	float GetTimeToTarget(float Tolerance = UE_KINDA_SMALL_NUMBER) const;
+
+	/// Called from Update when the value arrives at the target
+	FSimpleMulticastDelegate OnArrived;
+
 private:
 	UPROPERTY(EditAnywhere, meta = (AllowPrivateAccess))
 	bool bEnableInterpolation = false;
@@ -45,6 +62,8 @@ private:
 
 	UPROPERTY(Transient, VisibleAnywhere)
 	float Target = 0.0f;
+
+	bool bSettled = true;
 };
 
 USTRUCT(BlueprintType)
@@ -60,6 +79,7 @@ struct ZAKAZANEUTILITIES_API FZkzInterpolatedVectorValue
 
 	void Reset(const FVector& InValue);
 
+	/// Moves towards the target frame-rate independently, @see Zkz::Interpolation::TExponentialPolicy
 	void Update(float DeltaTime);
 
 	const FVector& GetCurrent() const;
@@ -72,6 +92,19 @@ struct ZAKAZANEUTILITIES_API FZkzInterpolatedVectorValue
 
 	void SetInterpSpeed(float InInterpSpeed);
 
+	/// True when Current reached Target. Settled values skip Update until given a new target - any target, even the
+	/// current value, which then settles (and broadcasts OnArrived) on the next Update, same as TInterpolatedValue.
+	bool IsSettled() const;
+
+	/// Returns the value it would have after updating by Time, without updating it
+	FVector PredictValue(float Time) const;
+
+	/// Returns the time after which the value stays within Tolerance of its target
+	float GetTimeToTarget(float Tolerance = UE_KINDA_SMALL_NUMBER) const;
+
+	/// Called from Update when the value arrives at the target
+	FSimpleMulticastDelegate OnArrived;
+
 private:
 	UPROPERTY(EditAnywhere, meta = (AllowPrivateAccess))
 	bool bEnableInterpolation = false;
@@ -84,6 +117,8 @@ private:
 
 	UPROPERTY(Transient, VisibleAnywhere)
 	FVector Target = FVector::ZeroVector;
+
+	bool bSettled = true;
 };
 
 USTRUCT(BlueprintType)
@@ -99,6 +134,7 @@ struct ZAKAZANEUTILITIES_API FZkzInterpolatedQuatValue
 
 	void Reset(const FQuat& InValue);
 
+	/// Moves towards the target frame-rate independently, @see Zkz::Interpolation::TExponentialPolicy
 	void Update(float DeltaTime);
 
 	const FQuat& GetCurrent() const;
@@ -111,6 +147,19 @@ struct ZAKAZANEUTILITIES_API FZkzInterpolatedQuatValue
 
 	void SetInterpSpeed(float InInterpSpeed);
 
+	/// True when Current reached Target. Settled values skip Update until given a new target - any target, even the
+	/// current value, which then settles (and broadcasts OnArrived) on the next Update, same as TInterpolatedValue.
+	bool IsSettled() const;
+
+	/// Returns the value it would have after updating by Time, without updating it
+	FQuat PredictValue(float Time) const;
+
+	/// Returns the time after which the value stays within Tolerance of its target
+	float GetTimeToTarget(float Tolerance = UE_KINDA_SMALL_NUMBER) const;
+
+	/// Called from Update when the value arrives at the target
+	FSimpleMulticastDelegate OnArrived;
+
 private:
 	UPROPERTY(EditAnywhere, meta = (AllowPrivateAccess))
 	bool bEnableInterpolation = false;
@@ -123,6 +172,73 @@ private:
 
 	UPROPERTY(Transient, VisibleAnywhere)
 	FQuat Target = FQuat::Identity;
+
+	bool bSettled = true;
+};
+
+/// Float moving from the value it had when the target was set to the target over a fixed duration, eased by a curve.
+/// The whole time range of the curve is stretched over the duration, its values are the fraction of the way to the
+/// target (0 at the start, 1 at the target). Without a curve, the value moves linearly.
+///
+/// The curve is baked into a lookup table shared by all values using the same curve, @see Zkz::FCurveLookupTable, so
+/// an update costs a single table lookup.
+USTRUCT(BlueprintType)
+struct ZAKAZANEUTILITIES_API FZkzCurveInterpolatedFloatValue
+{
+	GENERATED_BODY()
+
+	FZkzCurveInterpolatedFloatValue() = default;
+
+	FZkzCurveInterpolatedFloatValue(UCurveFloat* InCurve, float InDuration, float InValue = 0.0f);
+
+	void Reset(float InValue);
+
+	void Update(float DeltaTime);
+
+	float GetCurrent() const;
+
+	float GetTarget() const;
+
+	/// Starts a new motion from the current value, even if it's already at the target
+	void SetTarget(float InTarget);
+
+	/// Takes effect with the next target
+	void SetCurve(UCurveFloat* InCurve);
+
+	/// Takes effect with the next target
+	void SetDuration(float InDuration);
+
+	bool IsSettled() const;
+
+	/// Called from Update when the value arrives at the target
+	FSimpleMulticastDelegate OnArrived;
+
+private:
+	UPROPERTY(EditAnywhere, meta = (AllowPrivateAccess))
+	TObjectPtr<UCurveFloat> Curve;
+
+	UPROPERTY(EditAnywhere, meta = (AllowPrivateAccess, ClampMin = 0.0, Units = "Seconds"))
+	float Duration = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess))
+	float Current = 0.0f;
+
+	UPROPERTY(Transient, VisibleAnywhere)
+	float Target = 0.0f;
+
+	float Start = 0.0f;
+
+	float Elapsed = 0.0f;
+
+	bool bSettled = true;
+
+	/// Motion duration and curve, captured when the target is set
+	float MotionDuration = 0.0f;
+
+	TSharedPtr<const Zkz::FCurveLookupTable> LookupTable;
+
+	/// Curve the lookup table was baked from, to rebake when the curve changes (or is edited in the editor)
+	const UCurveFloat* BakedCurve = nullptr;
 };
 
 UCLASS()
@@ -156,4 +272,13 @@ public:
 
 	UFUNCTION(BlueprintCallable)
 	static void SetTargetQuat(FZkzInterpolatedQuatValue& InterpolatedQuat, const FQuat& Target);
+
+	UFUNCTION(BlueprintCallable)
+	static void ResetCurveFloat(FZkzCurveInterpolatedFloatValue& InterpolatedFloat, float Value);
+
+	UFUNCTION(BlueprintCallable)
+	static void UpdateCurveFloat(FZkzCurveInterpolatedFloatValue& InterpolatedFloat, float DeltaTime);
+
+	UFUNCTION(BlueprintCallable)
+	static void SetTargetCurveFloat(FZkzCurveInterpolatedFloatValue& InterpolatedFloat, float Target);
 };
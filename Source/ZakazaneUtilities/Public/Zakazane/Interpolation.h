@@ -0,0 +1,616 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "ReturnIfMacros.h"
+
+namespace Zkz
+{
+
+namespace Interpolation
+{
+
+/// Describes how to move a value of type T towards another. Values are moved by deltas: Delta(From, To) is the
+/// difference of two values, Apply(Base, Delta) offsets a value by it, with Apply(From, Delta(From, To)) == To.
+/// FDelta has to support addition and multiplication by float, which is all the policies need.
+template <class T>
+struct TInterpolationTraits;
+
+/// Shared implementation of types which are their own delta
+template <class T>
+struct TVectorSpaceInterpolationTraits
+{
+	using FDelta = T;
+
+	static FDelta Delta(const T& From, const T& To)
+	{
+		return To - From;
+	}
+
+	static T Apply(const T& Base, const FDelta& Delta)
+	{
+		return Base + Delta;
+	}
+};
+
+template <>
+struct TInterpolationTraits<float> : TVectorSpaceInterpolationTraits<float>
+{
+	static FDelta ZeroDelta()
+	{
+		return 0.0f;
+	}
+
+	static float Size(const FDelta Delta)
+	{
+		return FMath::Abs(Delta);
+	}
+};
+
+template <>
+struct TInterpolationTraits<FVector> : TVectorSpaceInterpolationTraits<FVector>
+{
+	static FDelta ZeroDelta()
+	{
+		return FVector::ZeroVector;
+	}
+
+	static float Size(const FDelta& Delta)
+	{
+		return Delta.Size();
+	}
+};
+
+template <>
+struct TInterpolationTraits<FLinearColor> : TVectorSpaceInterpolationTraits<FLinearColor>
+{
+	static FDelta ZeroDelta()
+	{
+		return FLinearColor{0.0f, 0.0f, 0.0f, 0.0f};
+	}
+
+	static float Size(const FDelta& Delta)
+	{
+		return FMath::Sqrt(
+			FMath::Square(Delta.R) + FMath::Square(Delta.G) + FMath::Square(Delta.B) + FMath::Square(Delta.A));
+	}
+};
+
+/// Rotations move along the shortest arc, deltas are rotation vectors (axis * angle in radians).
+template <>
+struct TInterpolationTraits<FQuat>
+{
+	using FDelta = FVector;
+
+	static FDelta ZeroDelta()
+	{
+		return FVector::ZeroVector;
+	}
+
+	static FDelta Delta(const FQuat& From, const FQuat& To)
+	{
+		FQuat Delta = To * From.Inverse();
+		Delta.EnforceShortestArcWith(FQuat::Identity);
+		return Delta.ToRotationVector();
+	}
+
+	static FQuat Apply(const FQuat& Base, const FDelta& Delta)
+	{
+		return (FQuat::MakeFromRotationVector(Delta) * Base).GetNormalized();
+	}
+
+	static float Size(const FDelta& Delta)
+	{
+		return Delta.Size();
+	}
+};
+
+/// Interpolated through quaternions, so that there's no gimbal lock nor winding
+template <>
+struct TInterpolationTraits<FRotator>
+{
+	using FDelta = FVector;
+
+	static FDelta ZeroDelta()
+	{
+		return FVector::ZeroVector;
+	}
+
+	static FDelta Delta(const FRotator& From, const FRotator& To)
+	{
+		return TInterpolationTraits<FQuat>::Delta(From.Quaternion(), To.Quaternion());
+	}
+
+	static FRotator Apply(const FRotator& Base, const FDelta& Delta)
+	{
+		return TInterpolationTraits<FQuat>::Apply(Base.Quaternion(), Delta).Rotator();
+	}
+
+	static float Size(const FDelta& Delta)
+	{
+		return Delta.Size();
+	}
+};
+
+/// Delta of transform components, @see TInterpolationTraits<FTransform>
+struct FTransformDelta
+{
+	FVector Translation = FVector::ZeroVector;
+
+	/// Rotation vector, @see TInterpolationTraits<FQuat>
+	FVector Rotation = FVector::ZeroVector;
+
+	FVector Scale3D = FVector::ZeroVector;
+
+	FTransformDelta operator+(const FTransformDelta& Other) const
+	{
+		return FTransformDelta{Translation + Other.Translation, Rotation + Other.Rotation, Scale3D + Other.Scale3D};
+	}
+
+	FTransformDelta operator*(const float Scale) const
+	{
+		return FTransformDelta{Translation * Scale, Rotation * Scale, Scale3D * Scale};
+	}
+};
+
+/// Components are interpolated independently, but all by the same fraction, so they arrive together. Size of a delta
+/// is the largest of its component sizes.
+template <>
+struct TInterpolationTraits<FTransform>
+{
+	using FDelta = FTransformDelta;
+
+	static FDelta ZeroDelta()
+	{
+		return FTransformDelta{};
+	}
+
+	static FDelta Delta(const FTransform& From, const FTransform& To)
+	{
+		return FTransformDelta{
+			To.GetTranslation() - From.GetTranslation(),
+			TInterpolationTraits<FQuat>::Delta(From.GetRotation(), To.GetRotation()),
+			To.GetScale3D() - From.GetScale3D()};
+	}
+
+	static FTransform Apply(const FTransform& Base, const FDelta& Delta)
+	{
+		return FTransform{
+			TInterpolationTraits<FQuat>::Apply(Base.GetRotation(), Delta.Rotation),
+			Base.GetTranslation() + Delta.Translation,
+			Base.GetScale3D() + Delta.Scale3D};
+	}
+
+	static float Size(const FDelta& Delta)
+	{
+		return FMath::Max3(Delta.Translation.Size(), Delta.Rotation.Size(), Delta.Scale3D.Size());
+	}
+};
+
+// -- Policies
+//
+// A policy holds the interpolation parameters along with any state the interpolation needs (e.g. velocity), and
+// provides:
+//   bool Advance(T& Current, const T& Target, float DeltaTime) - moves Current towards Target, returns true once
+//     Current arrived, in which case it's exactly Target
+//   void ResetState() - forgets the state, called when the value is reset
+//   T Evaluate(const T& Start, const T& Target, float Time) const - closed form of advancing from Start by Time
+//   void AdvanceState(const T& Start, const T& Target, float Time) - closed form of the state after the same
+//   float GetTimeToTarget(const T& Start, const T& Target, float Tolerance) const - time after which the value
+//     starting at Start stays within Tolerance of Target
+//
+// All policies are frame-rate independent: advancing by DeltaTime once or in several smaller steps gives the same
+// result (up to float precision). Non-positive speed / smooth time snaps straight to the target.
+
+/// Moves towards the target at a constant speed, in units (radians for rotations) per second.
+template <class T>
+struct TConstantSpeedPolicy
+{
+	using FTraits = TInterpolationTraits<T>;
+
+	float Speed = 1.0f;
+
+	bool Advance(T& Current, const T& Target, const float DeltaTime)
+	{
+		const typename FTraits::FDelta Delta = FTraits::Delta(Current, Target);
+		const float Distance = FTraits::Size(Delta);
+		const float MaxStep = Speed * DeltaTime;
+		if (Speed <= 0.0f || Distance <= MaxStep)
+		{
+			Current = Target;
+			return true;
+		}
+
+		Current = FTraits::Apply(Current, Delta * (MaxStep / Distance));
+		return false;
+	}
+
+	void ResetState()
+	{
+	}
+
+	T Evaluate(const T& Start, const T& Target, const float Time) const
+	{
+		const typename FTraits::FDelta Delta = FTraits::Delta(Start, Target);
+		const float Distance = FTraits::Size(Delta);
+		const float Travelled = Speed * Time;
+		ZKZ_RETURN_IF(Speed <= 0.0f || Distance <= Travelled, Target);
+
+		return FTraits::Apply(Start, Delta * (Travelled / Distance));
+	}
+
+	void AdvanceState(const T&, const T&, float)
+	{
+	}
+
+	float GetTimeToTarget(const T& Start, const T& Target, const float Tolerance) const
+	{
+		ZKZ_RETURN_IF(Speed <= 0.0f, 0.0f);
+		return FMath::Max(0.0f, FTraits::Size(FTraits::Delta(Start, Target)) - Tolerance) / Speed;
+	}
+};
+
+/// Closes the gap to the target exponentially, with the remaining distance decaying as exp(-Speed * t). For small
+/// time steps, this matches FMath::FInterpTo with the same speed.
+template <class T>
+struct TExponentialPolicy
+{
+	using FTraits = TInterpolationTraits<T>;
+
+	float Speed = 1.0f;
+
+	/// Distance to the target at which the value snaps to it
+	float Tolerance = UE_KINDA_SMALL_NUMBER;
+
+	bool Advance(T& Current, const T& Target, const float DeltaTime) const
+	{
+		const typename FTraits::FDelta Delta = FTraits::Delta(Current, Target);
+		const float Remaining = FMath::Exp(-Speed * DeltaTime);
+		if (Speed <= 0.0f || FTraits::Size(Delta) * Remaining < Tolerance)
+		{
+			Current = Target;
+			return true;
+		}
+
+		Current = FTraits::Apply(Current, Delta * (1.0f - Remaining));
+		return false;
+	}
+
+	void ResetState()
+	{
+	}
+
+	T Evaluate(const T& Start, const T& Target, const float Time) const
+	{
+		// Exact, so advancing once by Time gives the same result
+		T Value = Start;
+		Advance(Value, Target, Time);
+		return Value;
+	}
+
+	void AdvanceState(const T&, const T&, float)
+	{
+	}
+
+	float GetTimeToTarget(const T& Start, const T& Target, const float InTolerance) const
+	{
+		const float Distance = FTraits::Size(FTraits::Delta(Start, Target));
+		ZKZ_RETURN_IF(Speed <= 0.0f || Distance <= InTolerance, 0.0f);
+
+		return FMath::Loge(Distance / InTolerance) / Speed;
+	}
+};
+
+/// Critically damped spring: approaches the target as fast as possible without overshooting, keeping its velocity
+/// when the target changes, so retargeting doesn't cause jerks. Integrated in closed form, so it's stable for any
+/// time step.
+template <class T>
+struct TCriticallyDampedSpringPolicy
+{
+	using FTraits = TInterpolationTraits<T>;
+	using FDelta = typename FTraits::FDelta;
+
+	/// Roughly the time to reach the target
+	float SmoothTime = 0.2f;
+
+	/// Distance to the target and speed below which the value snaps to the target and stops
+	float Tolerance = UE_KINDA_SMALL_NUMBER;
+
+	FDelta Velocity = FTraits::ZeroDelta();
+
+	bool Advance(T& Current, const T& Target, const float DeltaTime)
+	{
+		if (SmoothTime <= 0.0f)
+		{
+			ResetState();
+			Current = Target;
+			return true;
+		}
+
+		const float Omega = 2.0f / SmoothTime;
+		const float Decay = FMath::Exp(-Omega * DeltaTime);
+
+		// Displacement from the target
+		const FDelta Offset = FTraits::Delta(Target, Current);
+		const FDelta Temp = (Velocity + Offset * Omega) * DeltaTime;
+		const FDelta NewOffset = (Offset + Temp) * Decay;
+		Velocity = (Velocity + Temp * -Omega) * Decay;
+
+		if (FTraits::Size(NewOffset) < Tolerance && FTraits::Size(Velocity) < Tolerance)
+		{
+			ResetState();
+			Current = Target;
+			return true;
+		}
+
+		Current = FTraits::Apply(Target, NewOffset);
+		return false;
+	}
+
+	void ResetState()
+	{
+		Velocity = FTraits::ZeroDelta();
+	}
+
+	/// Starts with the current velocity
+	T Evaluate(const T& Start, const T& Target, const float Time) const
+	{
+		ZKZ_RETURN_IF(SmoothTime <= 0.0f, Target);
+
+		const float Omega = 2.0f / SmoothTime;
+		const FDelta Offset = FTraits::Delta(Target, Start);
+		return FTraits::Apply(Target, (Offset + (Velocity + Offset * Omega) * Time) * FMath::Exp(-Omega * Time));
+	}
+
+	void AdvanceState(const T& Start, const T& Target, const float Time)
+	{
+		if (SmoothTime <= 0.0f)
+		{
+			ResetState();
+			return;
+		}
+
+		const float Omega = 2.0f / SmoothTime;
+		const FDelta Offset = FTraits::Delta(Target, Start);
+		Velocity = (Velocity + (Velocity + Offset * Omega) * (-Omega * Time)) * FMath::Exp(-Omega * Time);
+	}
+
+	/// Exact when starting at rest, otherwise an upper bound
+	float GetTimeToTarget(const T& Start, const T& Target, const float InTolerance) const
+	{
+		ZKZ_RETURN_IF(SmoothTime <= 0.0f, 0.0f);
+
+		// Distance to the target at time t is (A + B * t) * exp(-Omega * t) when starting at rest, and bounded by it
+		// otherwise
+		const float Omega = 2.0f / SmoothTime;
+		const FDelta Offset = FTraits::Delta(Target, Start);
+		const float A = FTraits::Size(Offset);
+		const float B = FTraits::Size(Velocity + Offset * Omega);
+		ZKZ_RETURN_IF(B <= UE_SMALL_NUMBER, A <= InTolerance ? 0.0f : FMath::Loge(A / InTolerance) / Omega);
+
+		// The bound peaks here, it only decreases afterwards
+		const float PeakTime = FMath::Max(0.0f, 1.0f / Omega - A / B);
+		ZKZ_RETURN_IF((A + B * PeakTime) * FMath::Exp(-Omega * PeakTime) <= InTolerance, 0.0f);
+
+		// Newton's method on the log of the bound, starting past the peak, where the slope is well away from zero. The
+		// log is concave, so the iterations approach the solution from above and never underestimate it.
+		const float LogTolerance = FMath::Loge(InTolerance);
+		float Time = FMath::Max(PeakTime, 2.0f / Omega - A / B);
+		for (int32 Iteration = 0; Iteration < 16; ++Iteration)
+		{
+			const float Error = FMath::Loge(A + B * Time) - Omega * Time - LogTolerance;
+			ZKZ_RETURN_IF(FMath::Abs(Error) < 1.0e-4f, Time);
+
+			const float Slope = B / (A + B * Time) - Omega;
+			Time = FMath::Max(PeakTime, Time - Error / Slope);
+		}
+
+		return Time;
+	}
+};
+
+}  // namespace Interpolation
+
+/// Value smoothly following its target, with the interpolation defined by a policy, @see Interpolation policies.
+/// Supports all types with Interpolation::TInterpolationTraits - float, FVector, FLinearColor, FQuat, FRotator and
+/// FTransform.
+///
+/// Values which arrived at their target are settled and Update does nothing until a new target is set. Setting any
+/// target wakes the value, even one equal to the current value, as the policy may still be in motion (e.g. a spring
+/// passing through its new target).
+template <class InValueType, class InPolicyType = Interpolation::TExponentialPolicy<InValueType>>
+class TInterpolatedValue
+{
+public:
+	using ValueType = InValueType;
+	using PolicyType = InPolicyType;
+
+	explicit TInterpolatedValue(const ValueType& Value, PolicyType InPolicy = PolicyType{})
+		: Current{Value}, Target{Value}, Policy{MoveTemp(InPolicy)}
+	{
+	}
+
+	/// Sets both current and target value, stopping any motion
+	void Reset(const ValueType& Value)
+	{
+		Current = Value;
+		Target = Value;
+		Policy.ResetState();
+		bSettled = true;
+	}
+
+	void SetTarget(const ValueType& InTarget)
+	{
+		Target = InTarget;
+		bSettled = false;
+	}
+
+	void Update(const float DeltaTime)
+	{
+		ZKZ_RETURN_IF(bSettled);
+
+		bSettled = Policy.Advance(Current, Target, DeltaTime);
+		if (bSettled)
+		{
+			OnArrived.Broadcast();
+		}
+	}
+
+	const ValueType& GetCurrent() const
+	{
+		return Current;
+	}
+
+	const ValueType& GetTarget() const
+	{
+		return Target;
+	}
+
+	bool IsSettled() const
+	{
+		return bSettled;
+	}
+
+	/// Returns the value it would have after updating by Time, without updating it
+	ValueType PredictValue(const float Time) const
+	{
+		ZKZ_RETURN_IF(bSettled, Target);
+		return Policy.Evaluate(Current, Target, Time);
+	}
+
+	/// Returns the time after which the value stays within Tolerance of its target
+	float GetTimeToTarget(const float Tolerance = UE_KINDA_SMALL_NUMBER) const
+	{
+		ZKZ_RETURN_IF(bSettled, 0.0f);
+		return Policy.GetTimeToTarget(Current, Target, Tolerance);
+	}
+
+	PolicyType& GetPolicy()
+	{
+		return Policy;
+	}
+
+	const PolicyType& GetPolicy() const
+	{
+		return Policy;
+	}
+
+	/// Called from Update when the value arrives at the target
+	FSimpleMulticastDelegate OnArrived;
+
+private:
+	ValueType Current;
+
+	ValueType Target;
+
+	PolicyType Policy;
+
+	bool bSettled = true;
+};
+
+/// Interpolated value evaluated in closed form on read, rather than integrated by updating it every frame. Only the
+/// start of the motion is stored, so values which are rarely read (e.g. off-screen) cost nothing per frame. Reading
+/// costs about as much as a single update of TInterpolatedValue, or nothing once the value arrived.
+///
+/// Times are absolute, in seconds, from any clock the owner uses consistently, e.g. UWorld::GetTimeSeconds.
+template <class InValueType, class InPolicyType = Interpolation::TExponentialPolicy<InValueType>>
+class TLazyInterpolatedValue
+{
+public:
+	using ValueType = InValueType;
+	using PolicyType = InPolicyType;
+
+	/// @param InTolerance - distance to the target at which the value is considered arrived and reads the target
+	explicit TLazyInterpolatedValue(
+		const ValueType& Value, PolicyType InPolicy = PolicyType{}, const float InTolerance = UE_KINDA_SMALL_NUMBER)
+		: Start{Value}, Target{Value}, Policy{MoveTemp(InPolicy)}, Tolerance{InTolerance}
+	{
+	}
+
+	/// Sets both current and target value, stopping any motion
+	void Reset(const ValueType& Value)
+	{
+		Start = Value;
+		Target = Value;
+		Policy.ResetState();
+		ArrivalTime = TNumericLimits<double>::Lowest();
+	}
+
+	/// Starts a new motion from the value at the given time, keeping the policy state (e.g. spring velocity)
+	void SetTarget(const ValueType& InTarget, const double Time)
+	{
+		const ValueType Current = GetValue(Time);
+		if (Time < ArrivalTime)
+		{
+			Policy.AdvanceState(Start, Target, GetElapsed(Time));
+		}
+		else
+		{
+			Policy.ResetState();
+		}
+
+		Start = Current;
+		Target = InTarget;
+		StartTime = Time;
+		ArrivalTime = Time + Policy.GetTimeToTarget(Start, Target, Tolerance);
+	}
+
+	ValueType GetValue(const double Time) const
+	{
+		ZKZ_RETURN_IF(Time >= ArrivalTime, Target);
+		return Policy.Evaluate(Start, Target, GetElapsed(Time));
+	}
+
+	const ValueType& GetTarget() const
+	{
+		return Target;
+	}
+
+	bool IsSettled(const double Time) const
+	{
+		return Time >= ArrivalTime;
+	}
+
+	/// Time at which the value arrives at its target
+	double GetArrivalTime() const
+	{
+		return ArrivalTime;
+	}
+
+	/// Returns the time after which the value stays within the given tolerance of its target
+	float GetTimeToTarget(const double Time, const float InTolerance) const
+	{
+		ZKZ_RETURN_IF(Time >= ArrivalTime, 0.0f);
+
+		const double ToleranceTime = StartTime + Policy.GetTimeToTarget(Start, Target, InTolerance);
+		return static_cast<float>(FMath::Max(0.0, ToleranceTime - Time));
+	}
+
+	/// Policy state is only advanced when the target changes. Changing the policy requires a new motion.
+	const PolicyType& GetPolicy() const
+	{
+		return Policy;
+	}
+
+private:
+	float GetElapsed(const double Time) const
+	{
+		return static_cast<float>(FMath::Max(0.0, Time - StartTime));
+	}
+
+	ValueType Start;
+
+	ValueType Target;
+
+	PolicyType Policy;
+
+	float Tolerance = UE_KINDA_SMALL_NUMBER;
+
+	double StartTime = 0.0;
+
+	double ArrivalTime = TNumericLimits<double>::Lowest();
+};
+
+}  // namespace Zkz
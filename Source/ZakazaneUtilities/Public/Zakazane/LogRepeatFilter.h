@@ -0,0 +1,51 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace Zkz
+{
+
+/// Rate limits repeated log messages: a message is let through once, its repeats within a time window are only
+/// counted, and once the window ends, a summary is emitted if there were any. Messages are identified by a key, a hash
+/// of whatever makes them the same message (e.g. category, severity, text and context object).
+///
+/// Thread safe. Summaries are emitted from Filter or Tick, outside of the lock.
+class ZAKAZANEUTILITIES_API FLogRepeatFilter
+{
+public:
+	/// Emits the summary of a message repeated the given number of times within a window
+	using FEmitSummary = TUniqueFunction<void(int32 /*NumRepeats*/)>;
+
+	/// Returns true if the message should be emitted, false if it's a repeat within the window. MakeEmitSummary is only
+	/// called for emitted messages, so that repeats cost no allocations. Non-positive window lets everything through.
+	bool Filter(uint32 Key, double Time, double Window, TFunctionRef<FEmitSummary()> MakeEmitSummary);
+
+	/// Ends the windows which elapsed by the given time, emitting their summaries. Meant to be called every frame.
+	void Tick(double Time);
+
+	/// Forgets all windows without emitting their summaries
+	void Reset();
+
+	/// Number of messages with an open window
+	int32 Num() const;
+
+private:
+	struct FWindow
+	{
+		double EndTime = 0.0;
+
+		int32 NumRepeats = 0;
+
+		FEmitSummary EmitSummary;
+	};
+
+	static void EmitSummaries(TArray<FWindow>& EndedWindows);
+
+	mutable FCriticalSection CriticalSection;
+
+	TMap<uint32, FWindow> Windows;
+};
+
+}  // namespace Zkz
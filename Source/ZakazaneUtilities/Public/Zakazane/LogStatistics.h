@@ -0,0 +1,140 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Containers/StaticArray.h"
+
+#include <atomic>
+
+namespace Zkz
+{
+
+/// Output device aggregating log statistics: number of messages and their size by category and verbosity, and the most
+/// frequent message templates (message text with numbers replaced by '#', so that "Took 12 ms" and "Took 7 ms" are the
+/// same template).
+///
+/// The global instance is registered to GLog on module startup, unless built with NO_LOGGING. It's reported with the
+/// Zkz.Log.Stats.Dump and Zkz.Log.Stats.DumpCSV console commands and cleared with Zkz.Log.Stats.Reset.
+///
+/// Counters are atomic, found by category under a read lock. Templates are tracked with the Space-Saving algorithm,
+/// separately by each logging thread, so that logging threads don't contend: a fixed number of candidates is kept and
+/// a new template replaces the least frequent one, inheriting its count as the error bound. The per-thread candidates
+/// are merged when reported, a template missing from a thread's full candidates counted as that thread's least
+/// frequent one. So the reported counts are upper bounds, exact for templates which never got replaced.
+class ZAKAZANEUTILITIES_API FLogStatistics : public FOutputDevice
+{
+public:
+	struct FCategoryStats
+	{
+		FName Category;
+
+		TStaticArray<int64, ELogVerbosity::NumVerbosity> NumMessages{InPlace, 0};
+
+		/// Message length in characters, which is close to the bytes written for mostly ASCII UTF-8 log files
+		TStaticArray<int64, ELogVerbosity::NumVerbosity> NumChars{InPlace, 0};
+
+		int64 GetNumMessagesWorseThan(ELogVerbosity::Type Verbosity) const;
+	};
+
+	struct FTemplateStats
+	{
+		FString Template;
+
+		FName Category;
+
+		ELogVerbosity::Type Verbosity = ELogVerbosity::NoLogging;
+
+		/// Upper bound of the number of messages
+		int64 Count = 0;
+
+		/// How much the count may be overestimated
+		int64 MaxError = 0;
+	};
+
+	/// Instance registered to GLog
+	static FLogStatistics& Get();
+
+	/// Tracks the given number of top templates, zero disables template tracking
+	explicit FLogStatistics(int32 InMaxTemplates = 32);
+
+	virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category) override;
+
+	virtual bool CanBeUsedOnMultipleThreads() const override;
+
+	virtual bool CanBeUsedOnAnyThread() const override;
+
+	/// Stats of all categories, the ones with the most errors, then warnings, then messages first
+	TArray<FCategoryStats> GetCategoryStats() const;
+
+	/// The most frequent templates, the most frequent first
+	TArray<FTemplateStats> GetTopTemplates() const;
+
+	void Reset();
+
+	/// Prints the category and template stats
+	void Dump(FOutputDevice& Output) const;
+
+	/// Writes the category stats as CSV to the given file and the template stats to a file next to it, with -Templates
+	/// appended to its name
+	bool ExportCSV(const FString& FilePath) const;
+
+	/// Message text with runs of digits (and hex numbers) replaced by '#', up to MaxTemplateLen characters
+	static FString MakeTemplate(const TCHAR* Message);
+
+	static constexpr int32 MaxTemplateLen = 256;
+
+private:
+	struct FCounters
+	{
+		std::atomic<int64> NumMessages[ELogVerbosity::NumVerbosity]{};
+
+		std::atomic<int64> NumChars[ELogVerbosity::NumVerbosity]{};
+	};
+
+	struct FTemplateCandidate
+	{
+		uint32 Key = 0;
+
+		FTemplateStats Stats;
+	};
+
+	/// Templates logged by a single thread
+	struct FThreadTemplates
+	{
+		uint32 ThreadId = 0;
+
+		/// Only contended while reporting or resetting
+		FCriticalSection CriticalSection;
+
+		/// More candidates than reported templates, to make the top ones more accurate
+		TArray<FTemplateCandidate> Candidates;
+
+		TMap<uint32, int32> CandidateIndices;
+	};
+
+	FCounters& FindOrAddCounters(FName Category);
+
+	FThreadTemplates& GetThreadTemplates();
+
+	void AddTemplate(const TCHAR* Message, uint32 TemplateHash, ELogVerbosity::Type Verbosity, FName Category);
+
+	/// Counters are never removed, only reset, so they can be used without holding the lock
+	TMap<FName, TUniquePtr<FCounters>> CountersByCategory;
+
+	mutable FRWLock CountersLock;
+
+	const int32 MaxTemplates;
+
+	/// Identifies the instance in the per-thread cache, as another one may be created at the same address
+	const uint32 InstanceId;
+
+	/// Templates of every thread that logged, kept after the thread exits and reused by threads getting its id
+	TArray<TSharedRef<FThreadTemplates>> ThreadTemplates;
+
+	/// Guards ThreadTemplates
+	mutable FCriticalSection TemplatesCriticalSection;
+};
+
+}  // namespace Zkz
@@ -4,19 +4,38 @@
 
 #include "CoreMinimal.h"
 
+#include "BinaryLog.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
 #include "Subsystems/EngineSubsystem.h"
+#include "Logging/MessageLog.h"
 #include "Logging/TokenizedMessage.h"
+#include "ReturnIfMacros.h"
 #include "Widgets/Notifications/SNotificationList.h"
 
 #include "Logging.generated.h"
 
-UCLASS()
+/// Logs user errors to the console right away and, in the editor, to the message log with a notification.
+///
+/// Message log and notification are updated in batches: errors may be logged from any thread, they're queued and the
+/// game thread drains the queue once per frame, with a single message log flush per category and a single
+/// notification update, so that logging thousands of errors (e.g. during content validation) doesn't stall the
+/// editor.
+///
+/// Repeats of the same error (same category, severity, message and context object) are suppressed for a while
+/// after it's logged and then logged once with their count, @see Zkz.Log.RepeatWindow.
+UCLASS(MinimalAPI)
 class UZkzLogSubsystem : public UEngineSubsystem
 {
 	GENERATED_BODY()
 
 public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
 	// TODO: #Log add blueprint callable function for user error logs
+	/// Thread safe
 	ZAKAZANEUTILITIES_API
 	void LogUserError(
 		const FLogCategoryBase& LogCategory,
@@ -25,6 +44,15 @@ public:
 		const UObject* ContextObject = nullptr,
 		const bool bTryPointToSourceObject = true);
 
+	/// LogUserError without recording to the binary log, for callers which recorded the message already. Thread safe
+	ZAKAZANEUTILITIES_API
+	void LogUnrecordedUserError(
+		const FLogCategoryBase& LogCategory,
+		const EMessageSeverity::Type Severity,
+		const FString& MessageStr,
+		const UObject* ContextObject = nullptr,
+		const bool bTryPointToSourceObject = true);
+
 #if NO_LOGGING
 	ZAKAZANEUTILITIES_API void LogUserError(
 		const FNoLoggingCategory& LogCategory,
@@ -34,10 +62,48 @@ public:
 		const bool bTryPointToSourceObject = true);
 #endif
 
+	/// Passes the queued user errors to the message log and notification right away, rather than on the next frame.
+	/// Game thread only.
+	ZAKAZANEUTILITIES_API void FlushUserErrors();
+
+#if WITH_EDITOR
+	DECLARE_MULTICAST_DELEGATE_TwoParams(
+		FOnUserErrorsFlushed, FName /*LogCategoryName*/, TConstArrayView<TSharedRef<FTokenizedMessage>> /*Messages*/);
+
+	/// Broadcast from FlushUserErrors once per category, after its messages were passed to the message log
+	FOnUserErrorsFlushed OnUserErrorsFlushed;
+#endif
+
 private:
+	void EmitUserError(
+		const FLogCategoryBase& LogCategory,
+		const EMessageSeverity::Type Severity,
+		const FString& MessageStr,
+		const UObject* ContextObject,
+		const bool bTryPointToSourceObject);
+
+	bool Tick(float DeltaTime);
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
 #if WITH_EDITOR
+	struct FQueuedUserError
+	{
+		FName LogCategoryName;
+		EMessageSeverity::Type Severity = EMessageSeverity::Error;
+		FString MessageStr;
+		TWeakObjectPtr<const UObject> ContextObject;
+		bool bTryPointToSourceObject = true;
+	};
+
+	TSharedRef<FTokenizedMessage> CreateTokenizedMessage(const FQueuedUserError& UserError) const;
+
+	void NotifyUserErrors(FName LogCategoryName, TConstArrayView<FQueuedUserError> UserErrors);
+
 	FString ConstructNotificationErrorString();
 
+	TQueue<FQueuedUserError, EQueueMode::Mpsc> QueuedUserErrors;
+
 	TSharedPtr<SNotificationItem> MessageNotificationActive;
 	TArray<FString> MessageNotificationsToDisplay;
 #endif
@@ -49,6 +115,8 @@ namespace Zkz
 void LogToScreenAndConsole(const FNoLoggingCategory& Category, ELogVerbosity::Type Verbosity, const FString& Message);
 #endif
 
+/// Repeats of the same message are suppressed for a while and then logged once with their count, @see
+/// Zkz.Log.RepeatWindow. On screen, repeats replace the previous message rather than stacking.
 ZAKAZANEUTILITIES_API
 void LogToScreenAndConsole(const FLogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FString& Message);
 
@@ -84,4 +152,95 @@ ZAKAZANEUTILITIES_API void LogUserError(
 	const UObject* ContextObject = nullptr,
 	const bool bTryPointToSourceObject = true);
 #endif
+
+namespace LoggingPrivate
+{
+/// FLogCategory has a compile time verbosity, FLogCategoryBase and FNoLoggingCategory don't
+template <class CategoryType, class = void>
+constexpr bool HasCompileTimeVerbosity_V = false;
+
+template <class CategoryType>
+constexpr bool
+	HasCompileTimeVerbosity_V<CategoryType, std::void_t<decltype(CategoryType::CompileTimeVerbosity)>> = true;
+
+/// True if the category would write a message of the given verbosity
+template <class CategoryType>
+bool IsActive(const CategoryType& Category, const ELogVerbosity::Type Verbosity)
+{
+	if constexpr (HasCompileTimeVerbosity_V<CategoryType>)
+	{
+		ZKZ_RETURN_IF((Verbosity & ELogVerbosity::VerbosityMask) > CategoryType::CompileTimeVerbosity, false);
+	}
+
+	return !Category.IsSuppressed(Verbosity);
+}
+
+/// LogToScreenAndConsole without recording to the binary log, for callers which recorded the message already
+ZAKAZANEUTILITIES_API
+void LogUnrecordedToScreenAndConsole(
+	const FLogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FString& Message);
+
+/// LogUserError without recording to the binary log, for callers which recorded the message already
+ZAKAZANEUTILITIES_API
+void LogUnrecordedUserError(
+	const FLogCategoryBase& LogCategory,
+	const EMessageSeverity::Type Severity,
+	const FString& MessageStr,
+	const UObject* ContextObject,
+	const bool bTryPointToSourceObject);
+} // namespace LoggingPrivate
+
+/// Formatting counterpart of LogToScreenAndConsole. The message is only formatted if the category would write it,
+/// so suppressed and compiled out messages cost next to nothing. While the binary log is recording, messages are
+/// recorded unformatted, written or not, @see Zkz::BinaryLog.
+template <class CategoryType, class FormatType, class... ArgTypes>
+void LogToScreenAndConsolef(
+	const CategoryType& Category, const ELogVerbosity::Type Verbosity, const FormatType& Format, ArgTypes... Args)
+{
+#if !NO_LOGGING
+#if ZKZ_WITH_BINARY_LOG
+	BinaryLog::Record(Category.GetCategoryName(), Verbosity, Format, Args...);
+#endif
+	ZKZ_RETURN_IF(!LoggingPrivate::IsActive(Category, Verbosity));
+
+	LoggingPrivate::LogUnrecordedToScreenAndConsole(Category, Verbosity, FString::Printf(Format, Args...));
+#endif
+}
+
+/// Formatting counterpart of LogUserError. In the editor the message always goes to the message log, so it's always
+/// formatted. Elsewhere it's only formatted if the category would write it to the console. Recorded to the binary log
+/// unformatted, the same as LogToScreenAndConsolef.
+template <class CategoryType, class FormatType, class... ArgTypes>
+void LogUserErrorf(
+	const CategoryType& LogCategory,
+	const EMessageSeverity::Type Severity,
+	const UObject* ContextObject,
+	const bool bTryPointToSourceObject,
+	const FormatType& Format,
+	ArgTypes... Args)
+{
+#if !NO_LOGGING
+#if ZKZ_WITH_BINARY_LOG
+	BinaryLog::Record(LogCategory.GetCategoryName(), FMessageLog::GetLogVerbosity(Severity), Format, Args...);
+#endif
+#if !WITH_EDITOR
+	ZKZ_RETURN_IF(!LoggingPrivate::IsActive(LogCategory, FMessageLog::GetLogVerbosity(Severity)));
+#endif
+
+	LoggingPrivate::LogUnrecordedUserError(
+		LogCategory, Severity, FString::Printf(Format, Args...), ContextObject, bTryPointToSourceObject);
+#endif
+}
+
+/// LogUserErrorf pointing to the editor counterpart of ContextObject, the same as LogUserError by default
+template <class CategoryType, class FormatType, class... ArgTypes UE_REQUIRES(!std::is_same_v<FormatType, bool>)>
+void LogUserErrorf(
+	const CategoryType& LogCategory,
+	const EMessageSeverity::Type Severity,
+	const UObject* ContextObject,
+	const FormatType& Format,
+	ArgTypes... Args)
+{
+	LogUserErrorf(LogCategory, Severity, ContextObject, true, Format, Args...);
+}
 } // namespace Zkz
\ No newline at end of file
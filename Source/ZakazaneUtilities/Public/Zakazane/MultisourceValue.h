@@ -4,23 +4,88 @@
 
 #include "CoreMinimal.h"
 
-#include "Algo/Accumulate.h"
+#include "GenerationalSlots.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/ScopeLock.h"
+#include "Monostate.h"
+#include "ReturnIfMacros.h"
+#include "TimerWheel.h"
+
+#include <atomic>
+
+/// Makes FAtomicIfAnyMultisourceValue remember its active sources (with their debug names) for diagnostics, at the
+/// cost of a lock on push and pop.
+#ifndef ZKZ_ATOMIC_MULTISOURCE_TRACK_SOURCES
+#define ZKZ_ATOMIC_MULTISOURCE_TRACK_SOURCES 0
+#endif
 
 namespace Zkz
 {
 
+namespace MultisourceValue
+{
+
+/// Passed to PushExpiringValue: the source is popped automatically after the given time (in seconds).
+struct FExpireAfter
+{
+	double Seconds = 0.0;
+
+	/// Wheel driving the expiry, FSharedTimerWheel if null. The expiry happens on the thread advancing the wheel.
+	FTimerWheel* TimerWheel = nullptr;
+};
+
+template <class MultisourceValueType, ESPMode Mode, class... ArgTypes>
+typename MultisourceValueType::SourceIdType PushExpiringValue(
+	const TSharedRef<MultisourceValueType, Mode>& Value, FExpireAfter ExpireAfter, ArgTypes&&... Args);
+
+namespace Private
+{
+
+/// Counts the expiry timers pending for a multisource value. Copies would keep the expiring sources forever (and
+/// overwritten values would have unrelated sources popped), so copying is only allowed when there are none.
+struct FPendingExpiries
+{
+	FPendingExpiries() = default;
+
+	FPendingExpiries(const FPendingExpiries& Other)
+	{
+		checkf(Other.Num == 0, TEXT("Copying a multisource value with pending expiring sources"));
+	}
+
+	FPendingExpiries& operator=(const FPendingExpiries& Other)
+	{
+		checkf(Num == 0 && Other.Num == 0, TEXT("Copying a multisource value with pending expiring sources"));
+		return *this;
+	}
+
+	int32 Num = 0;
+};
+
+}  // namespace Private
+
+}  // namespace MultisourceValue
+
 /// TMultisourceValue is a solution for values that may be modified by many different sources and need some sort
 /// of custom conflict resolution when multiple sources are active.
 /// E.g. movement speed - this may be modified by various rules, such as - move slower indoors, move slower in
 /// buildings, move slower when wounded, move faster in combat or in a dialogue. In this case we'd probably want
 /// some sort of priority based stack, where modifiers would be pushed onto it, but only the ones with the
 /// highest priority would be applied.
+/// OnValueChanged is broadcast whenever pushing or popping a source, or changing the default value, changes the
+/// resolved value, so consumers don't need to poll GetValue. The resolved value is only compared (and copied) when the
+/// delegate is bound.
+/// Temporary sources can be pushed onto shared values with MultisourceValue::PushExpiringValue, e.g.
+/// PushExpiringValue(Speed, FExpireAfter{2.0}, 0.5f, 1) for a 2 second slow. Expiry of all such sources is driven by
+/// a timer wheel (FSharedTimerWheel by default), so there's no per-source timer to manage. Handles of expiring sources
+/// may still be popped manually before they expire. Values can't be copied while expiring sources are pending.
 template <class InValueType, template <class, class, class...> class InResolverType, class... ResolverArgs>
 class TMultisourceValue : InResolverType<InValueType, TMultisourceValue<InValueType, InResolverType>, ResolverArgs...>
 {
 public:
 	using ValueType = InValueType;
 	using ResolverType = InResolverType<InValueType, TMultisourceValue<InValueType, InResolverType>, ResolverArgs...>;
+	using SourceIdType = typename ResolverType::SourceIdType;
+	using FOnValueChanged = TMulticastDelegate<void(const ValueType& NewValue)>;
 
 	TMultisourceValue() = default;
 
@@ -30,7 +95,7 @@ public:
 
 	void SetDefaultValue(ValueType InDefaultValue)
 	{
-		DefaultValue = MoveTemp(InDefaultValue);
+		NotifyIfValueChanged([this, &InDefaultValue] { DefaultValue = MoveTemp(InDefaultValue); });
 	}
 
 	const ValueType& GetDefaultValue() const
@@ -38,21 +103,120 @@ public:
 		return DefaultValue;
 	}
 
+	/// @see ResolverType::PushValue
+	template <class... ArgTypes>
+	auto PushValue(ArgTypes&&... Args)
+	{
+		return NotifyIfValueChanged([&] { return ResolverType::PushValue(Forward<ArgTypes>(Args)...); });
+	}
+
+	/// @see ResolverType::PopValue
+	template <class... ArgTypes>
+	void PopValue(ArgTypes&&... Args)
+	{
+		NotifyIfValueChanged([&] { ResolverType::PopValue(Forward<ArgTypes>(Args)...); });
+	}
+
 	using ResolverType::GetValue;
-	using ResolverType::PopValue;
-	using ResolverType::PushValue;
+
+	/// Gives access to resolver specific settings, e.g. TClampedSumResolver::SetClampRange. Broadcasts OnValueChanged
+	/// if the modification changes the resolved value.
+	template <class FuncType>
+	void ModifyResolver(FuncType&& Func)
+	{
+		NotifyIfValueChanged([&] { ::Invoke(Func, static_cast<ResolverType&>(*this)); });
+	}
+
+	const ResolverType& GetResolver() const
+	{
+		return *this;
+	}
+
+	FOnValueChanged OnValueChanged;
 
 private:
+	/// Calls the modification, broadcasting OnValueChanged if it changed the resolved value.
+	template <class ModificationType>
+	decltype(auto) NotifyIfValueChanged(ModificationType&& Modification)
+	{
+		if (!OnValueChanged.IsBound())
+		{
+			return Modification();
+		}
+
+		const ValueType OldValue = GetValue();
+		ON_SCOPE_EXIT
+		{
+			if (!(GetValue() == OldValue))
+			{
+				OnValueChanged.Broadcast(GetValue());
+			}
+		};
+
+		return Modification();
+	}
+
 	ValueType DefaultValue;
 
+	MultisourceValue::Private::FPendingExpiries PendingExpiries;
+
 	friend class ResolverType;	// need to befriend resolver so that it may static_cast to TMultisourceValue
+
+	template <class MultisourceValueType, ESPMode Mode, class... ArgTypes>
+	friend typename MultisourceValueType::SourceIdType MultisourceValue::PushExpiringValue(
+		const TSharedRef<MultisourceValueType, Mode>& Value,
+		MultisourceValue::FExpireAfter ExpireAfter,
+		ArgTypes&&... Args);
 };
 
+namespace MultisourceValue
+{
+
+/// Pushes a source which is popped automatically after the given time. The expiry timer only holds a weak reference
+/// to the value, so a value destroyed before that is left alone. Must be called on the thread advancing the timer
+/// wheel (the game thread for FSharedTimerWheel). @see TMultisourceValue::PushValue
+template <class MultisourceValueType, ESPMode Mode, class... ArgTypes>
+typename MultisourceValueType::SourceIdType PushExpiringValue(
+	const TSharedRef<MultisourceValueType, Mode>& Value, const FExpireAfter ExpireAfter, ArgTypes&&... Args)
+{
+	check(ExpireAfter.TimerWheel != nullptr || IsInGameThread());
+
+	const typename MultisourceValueType::SourceIdType SourceId = Value->PushValue(Forward<ArgTypes>(Args)...);
+	++Value->PendingExpiries.Num;
+
+	FTimerWheel::FCallback Expire = [WeakValue = TWeakPtr<MultisourceValueType, Mode>{Value}, SourceId]
+	{
+		if (const TSharedPtr<MultisourceValueType, Mode> PinnedValue = WeakValue.Pin())
+		{
+			// Popping an already popped source is a no-op, thanks to the generational handles
+			--PinnedValue->PendingExpiries.Num;
+			PinnedValue->PopValue(SourceId);
+		}
+	};
+
+	if (ExpireAfter.TimerWheel != nullptr)
+	{
+		ExpireAfter.TimerWheel->Schedule(ExpireAfter.Seconds, MoveTemp(Expire));
+	}
+	else
+	{
+		FSharedTimerWheel::Get().Schedule(ExpireAfter.Seconds, MoveTemp(Expire));
+	}
+
+	return SourceId;
+}
+
+}  // namespace MultisourceValue
+
 // -- Resolvers
 
 namespace MultisourceValue
 {
 
+/// Handle identifying a value source, returned by PushValue and passed back to PopValue. Popping with a stale handle
+/// (already popped) is a safe no-op.
+using FSourceHandle = FGenerationalHandle;
+
 /// Returns DefaultValue if there are no sources added, !DefaultValue otherwise. E.g. we want to know
 /// whether an object is highlighted. DefaultValue is false, then if anyone does PushValue() we return
 /// true.
@@ -61,16 +225,16 @@ class TIfAnyResolver
 {
 public:
 	using ValueType = bool;
-	using SourceType = const void*;
+	using SourceIdType = FSourceHandle;
 
-	void PushValue(SourceType Source)
+	SourceIdType PushValue()
 	{
-		Sources.Emplace(Source);
+		return Sources.Add(FMonostate{});
 	}
 
-	void PopValue(const SourceType Source)
+	void PopValue(const SourceIdType SourceId)
 	{
-		Sources.Remove(Source);
+		Sources.Remove(SourceId);
 	}
 
 	bool GetValue() const
@@ -80,11 +244,154 @@ public:
 	}
 
 private:
-	TSet<SourceType> Sources;
+	TGenerationalSlots<FMonostate> Sources;
 };
 
+namespace Private
+{
+
+/// Binary heap of source entries, with O(1) lookup of an entry's heap position by its source handle. Top is O(1),
+/// Push and Remove are O(log n).
+/// @tparam PredicateType - returns true if the first entry belongs closer to the top than the second one
+template <class EntryType, class PredicateType>
+class TIndexedHeap
+{
+public:
+	FSourceHandle Push(EntryType Entry)
+	{
+		const int32 HeapIdx = Heap.Emplace(FNode{FSourceHandle{}, MoveTemp(Entry)});
+		const FSourceHandle Handle = HeapIndices.Add(HeapIdx);
+		Heap[HeapIdx].Handle = Handle;
+		SiftUp(HeapIdx);
+
+		return Handle;
+	}
+
+	/// Returns false if the handle is stale or was never valid.
+	bool Remove(const FSourceHandle Handle)
+	{
+		int32 HeapIdx = INDEX_NONE;
+		ZKZ_RETURN_IF(!HeapIndices.RemoveAndCopyValue(Handle, HeapIdx), false);
+
+		// Fill the gap with the last node and restore the heap property from there
+		FNode LastNode = Heap.Pop(EAllowShrinking::No);
+		ZKZ_RETURN_IF(HeapIdx == Heap.Num(), true);
+
+		Heap[HeapIdx] = MoveTemp(LastNode);
+		HeapIndices[Heap[HeapIdx].Handle] = HeapIdx;
+
+		if (SiftUp(HeapIdx) == HeapIdx)
+		{
+			SiftDown(HeapIdx);
+		}
+
+		return true;
+	}
+
+	const EntryType& Top() const
+	{
+		check(!Heap.IsEmpty());
+		return Heap[0].Entry;
+	}
+
+	bool IsEmpty() const
+	{
+		return Heap.IsEmpty();
+	}
+
+private:
+	struct FNode
+	{
+		FSourceHandle Handle;
+
+		EntryType Entry;
+	};
+
+	void SwapNodes(const int32 HeapIdx, const int32 OtherHeapIdx)
+	{
+		Heap.Swap(HeapIdx, OtherHeapIdx);
+		HeapIndices[Heap[HeapIdx].Handle] = HeapIdx;
+		HeapIndices[Heap[OtherHeapIdx].Handle] = OtherHeapIdx;
+	}
+
+	/// Returns the final index of the node
+	int32 SiftUp(int32 HeapIdx)
+	{
+		while (HeapIdx > 0)
+		{
+			const int32 ParentIdx = (HeapIdx - 1) / 2;
+			if (!PredicateType{}(Heap[HeapIdx].Entry, Heap[ParentIdx].Entry))
+			{
+				break;
+			}
+
+			SwapNodes(HeapIdx, ParentIdx);
+			HeapIdx = ParentIdx;
+		}
+
+		return HeapIdx;
+	}
+
+	void SiftDown(int32 HeapIdx)
+	{
+		while (true)
+		{
+			int32 TopIdx = HeapIdx;
+			for (const int32 ChildIdx : {2 * HeapIdx + 1, 2 * HeapIdx + 2})
+			{
+				if (ChildIdx < Heap.Num() && PredicateType{}(Heap[ChildIdx].Entry, Heap[TopIdx].Entry))
+				{
+					TopIdx = ChildIdx;
+				}
+			}
+
+			ZKZ_RETURN_IF(TopIdx == HeapIdx);
+
+			SwapNodes(HeapIdx, TopIdx);
+			HeapIdx = TopIdx;
+		}
+	}
+
+	/// The top entry is always at index 0
+	TArray<FNode> Heap;
+
+	/// Heap index of each entry, for O(1) lookup when removing
+	TGenerationalSlots<int32> HeapIndices;
+};
+
+/// Resolves to the top value of a heap ordered by PredicateType, or to the default value if there are no sources.
+template <class InValueType, class MultisourceValueType, class PredicateType>
+class THeapResolver
+{
+public:
+	using ValueType = InValueType;
+	using SourceIdType = FSourceHandle;
+
+	SourceIdType PushValue(ValueType Value)
+	{
+		return Sources.Push(MoveTemp(Value));
+	}
+
+	void PopValue(const SourceIdType SourceId)
+	{
+		Sources.Remove(SourceId);
+	}
+
+	const ValueType& GetValue() const
+	{
+		return Sources.IsEmpty() ? static_cast<const MultisourceValueType&>(*this).GetDefaultValue() : Sources.Top();
+	}
+
+private:
+	TIndexedHeap<ValueType, PredicateType> Sources;
+};
+
+}  // namespace Private
+
 /// Value sources are added with a priority value. Value from the source with the highest priority is returned. If
 /// multiple sources have the same priority, the one added the most recently wins.
+/// Sources are kept in a binary max-heap indexed by source handle, so GetValue is O(1), PushValue and PopValue are
+/// O(log n). Fit for values read every frame by many systems, while sources change only occasionally.
 /// @tparam InValueType - automatically filled in by TMultisourceValue: this is the value type to be resolved
 /// @tparam MultisourceValueType - child TMultisourceValue (CRTP)
 template <class InValueType, class MultisourceValueType>
@@ -92,7 +399,7 @@ class TPriorityBasedResolver
 {
 public:
 	using ValueType = InValueType;
-	using SourceIdType = int32;
+	using SourceIdType = FSourceHandle;
 	using PriorityType = int32;
 
 	/// Pushes the given value onto the stack with the given priority.
@@ -101,54 +408,61 @@ public:
 	template <class PriorityArgType>
 	SourceIdType PushValue(ValueType Value, PriorityArgType Priority)
 	{
-		SourceIdType SourceId = ++LastSourceId;
-		Sources.Emplace(FSourceEntry{SourceId, static_cast<PriorityType>(Priority), MoveTemp(Value)});
-		return SourceId;
+		return Sources.Push(FSourceEntry{++LastPushOrder, static_cast<PriorityType>(Priority), MoveTemp(Value)});
 	}
 
-	void PopValue(SourceIdType SourceId)
+	void PopValue(const SourceIdType SourceId)
 	{
-		Sources.RemoveAllSwap([SourceId](const FSourceEntry& Source) { return Source.SourceId == SourceId; });
+		Sources.Remove(SourceId);
 	}
 
-	ValueType GetValue() const
+	const ValueType& GetValue() const
 	{
-		if (Sources.IsEmpty())
-		{
-			return static_cast<const MultisourceValueType&>(*this).GetDefaultValue();
-		}
-
-		const FSourceEntry* MaxPriorityEntry = nullptr;
-		for (const FSourceEntry& Entry : Sources)
-		{
-			if (MaxPriorityEntry == nullptr || Entry.Priority > MaxPriorityEntry->Priority
-				|| (Entry.Priority == MaxPriorityEntry->Priority && Entry.SourceId > MaxPriorityEntry->SourceId))
-			{
-				MaxPriorityEntry = &Entry;
-			}
-		}
-
-		return MaxPriorityEntry->Value;
+		return Sources.IsEmpty() ? static_cast<const MultisourceValueType&>(*this).GetDefaultValue()
+								 : Sources.Top().Value;
 	}
 
 private:
 	struct FSourceEntry
 	{
-		SourceIdType SourceId = -1;
+		/// Breaks priority ties in favour of the most recently pushed source
+		uint64 PushOrder = 0;
 
 		PriorityType Priority = -1;
 
 		ValueType Value;
 	};
 
-	SourceIdType LastSourceId = 0;
+	struct FOutranks
+	{
+		bool operator()(const FSourceEntry& Entry, const FSourceEntry& OtherEntry) const
+		{
+			return Entry.Priority > OtherEntry.Priority
+				|| (Entry.Priority == OtherEntry.Priority && Entry.PushOrder > OtherEntry.PushOrder);
+		}
+	};
+
+	uint64 LastPushOrder = 0;
 
-	TArray<FSourceEntry> Sources;
+	Private::TIndexedHeap<FSourceEntry, FOutranks> Sources;
 };
 
-// #TODO #MultisourceValue: resolvers need to have a type parameter for source id type or at
-// least use a variant for int32 / fname / pointer
-/// All value sources are summed up.
+/// The lowest of the source values is returned, or DefaultValue if there are no sources. E.g. the strongest slow
+/// of all applied slows. GetValue is O(1), PushValue and PopValue are O(log n).
+/// @tparam InValueType - automatically filled in by TMultisourceValue: this is the value type to be resolved
+/// @tparam MultisourceValueType - child TMultisourceValue (CRTP)
+template <class InValueType, class MultisourceValueType>
+using TMinResolver = Private::THeapResolver<InValueType, MultisourceValueType, TLess<>>;
+
+/// The highest of the source values is returned, or DefaultValue if there are no sources. E.g. the strongest haste
+/// of all applied hastes. GetValue is O(1), PushValue and PopValue are O(log n).
+/// @tparam InValueType - automatically filled in by TMultisourceValue: this is the value type to be resolved
+/// @tparam MultisourceValueType - child TMultisourceValue (CRTP)
+template <class InValueType, class MultisourceValueType>
+using TMaxResolver = Private::THeapResolver<InValueType, MultisourceValueType, TGreater<>>;
+
+/// All value sources are summed up. The sum is kept incrementally - adjusted on push and pop - so GetValue is O(1).
+/// To avoid accumulating floating point error forever, it's reset to exact zero whenever the last source is popped.
 /// @tparam InValueType - automatically filled in by TMultisourceValue: this is the value type to be resolved
 /// @tparam MultisourceValueType - child TMultisourceValue (CRTP)
 template <class InValueType, class MultisourceValueType>
@@ -156,32 +470,158 @@ class TSumResolver
 {
 public:
 	using ValueType = InValueType;
-	using SourceIdType = TObjectPtr<const UObject>;
+	using SourceIdType = FSourceHandle;
 
-	void PushValue(SourceIdType SourceId, ValueType Value)
+	SourceIdType PushValue(ValueType Value)
 	{
-		Sources.Emplace(FSourceEntry{SourceId, Value});
+		Sum += Value;
+		return Sources.Add(MoveTemp(Value));
 	}
 
-	void PopValue(SourceIdType SourceId)
+	void PopValue(const SourceIdType SourceId)
 	{
-		Sources.RemoveAllSwap([SourceId](const FSourceEntry& Source) { return Source.SourceId == SourceId; });
+		ValueType Value{0};
+		ZKZ_RETURN_IF(!Sources.RemoveAndCopyValue(SourceId, Value));
+
+		Sum = Sources.IsEmpty() ? ValueType{0} : Sum - Value;
 	}
 
-	ValueType GetValue() const
+	const ValueType& GetValue() const
 	{
-		return Algo::TransformAccumulate(Sources, &FSourceEntry::Value, ValueType{0});
+		return Sum;
 	}
 
 private:
-	struct FSourceEntry
+	TGenerationalSlots<ValueType> Sources;
+
+	ValueType Sum{0};
+};
+
+/// All value sources are multiplied. Zeros are counted separately and the product of the non-zero values is kept
+/// incrementally (multiplied on push, divided on pop), so all operations are O(1) and popping a zero doesn't need a
+/// rescan. As with TSumResolver, the product is reset to exact one whenever the last non-zero source is popped.
+/// @tparam InValueType - automatically filled in by TMultisourceValue: this is the value type to be resolved
+/// @tparam MultisourceValueType - child TMultisourceValue (CRTP)
+template <class InValueType, class MultisourceValueType>
+class TProductResolver
+{
+public:
+	using ValueType = InValueType;
+	using SourceIdType = FSourceHandle;
+
+	SourceIdType PushValue(ValueType Value)
 	{
-		SourceIdType SourceId = nullptr;
+		if (Value == ValueType{0})
+		{
+			++NumZeros;
+		}
+		else
+		{
+			NonZeroProduct *= Value;
+			++NumNonZeros;
+		}
 
-		ValueType Value;
-	};
+		UpdateValue();
+		return Sources.Add(MoveTemp(Value));
+	}
+
+	void PopValue(const SourceIdType SourceId)
+	{
+		ValueType Value{0};
+		ZKZ_RETURN_IF(!Sources.RemoveAndCopyValue(SourceId, Value));
+
+		if (Value == ValueType{0})
+		{
+			--NumZeros;
+		}
+		else
+		{
+			--NumNonZeros;
+			NonZeroProduct = NumNonZeros == 0 ? ValueType{1} : NonZeroProduct / Value;
+		}
+
+		UpdateValue();
+	}
+
+	const ValueType& GetValue() const
+	{
+		return Product;
+	}
+
+private:
+	void UpdateValue()
+	{
+		Product = NumZeros > 0 ? ValueType{0} : NonZeroProduct;
+	}
+
+	TGenerationalSlots<ValueType> Sources;
+
+	ValueType NonZeroProduct{1};
+
+	ValueType Product{1};
 
-	TArray<FSourceEntry> Sources;
+	int32 NumZeros = 0;
+
+	int32 NumNonZeros = 0;
+};
+
+/// All value sources are summed up and the sum is clamped to a range, e.g. stacking movement speed modifiers while
+/// never going below a minimum. The range is unbounded until set with SetClampRange, use
+/// TMultisourceValue::ModifyResolver for that.
+/// @tparam InValueType - automatically filled in by TMultisourceValue: this is the value type to be resolved
+/// @tparam MultisourceValueType - child TMultisourceValue (CRTP)
+template <class InValueType, class MultisourceValueType>
+class TClampedSumResolver : public TSumResolver<InValueType, MultisourceValueType>
+{
+	using Super = TSumResolver<InValueType, MultisourceValueType>;
+
+public:
+	using typename Super::SourceIdType;
+	using typename Super::ValueType;
+
+	SourceIdType PushValue(ValueType Value)
+	{
+		const SourceIdType SourceId = Super::PushValue(MoveTemp(Value));
+		UpdateValue();
+		return SourceId;
+	}
+
+	void PopValue(const SourceIdType SourceId)
+	{
+		Super::PopValue(SourceId);
+		UpdateValue();
+	}
+
+	const ValueType& GetValue() const
+	{
+		return ClampedSum;
+	}
+
+	const ValueType& GetUnclampedValue() const
+	{
+		return Super::GetValue();
+	}
+
+	void SetClampRange(ValueType InMinValue, ValueType InMaxValue)
+	{
+		ensureMsgf(InMinValue <= InMaxValue, TEXT("Invalid clamp range"));
+
+		MinValue = MoveTemp(InMinValue);
+		MaxValue = MoveTemp(InMaxValue);
+		UpdateValue();
+	}
+
+private:
+	void UpdateValue()
+	{
+		ClampedSum = FMath::Clamp(Super::GetValue(), MinValue, MaxValue);
+	}
+
+	ValueType MinValue = TNumericLimits<ValueType>::Lowest();
+
+	ValueType MaxValue = TNumericLimits<ValueType>::Max();
+
+	ValueType ClampedSum{0};
 };
 
 }  // namespace MultisourceValue
@@ -191,6 +631,179 @@ private:
 template <class ValueType>
 using TPriorityBasedMultisourceValue = TMultisourceValue<ValueType, MultisourceValue::TPriorityBasedResolver>;
 
+template <class ValueType>
+using TSumMultisourceValue = TMultisourceValue<ValueType, MultisourceValue::TSumResolver>;
+
+template <class ValueType>
+using TClampedSumMultisourceValue = TMultisourceValue<ValueType, MultisourceValue::TClampedSumResolver>;
+
+template <class ValueType>
+using TProductMultisourceValue = TMultisourceValue<ValueType, MultisourceValue::TProductResolver>;
+
+template <class ValueType>
+using TMinMultisourceValue = TMultisourceValue<ValueType, MultisourceValue::TMinResolver>;
+
+template <class ValueType>
+using TMaxMultisourceValue = TMultisourceValue<ValueType, MultisourceValue::TMaxResolver>;
+
 using FIfAnyMultisourceValue = TMultisourceValue<bool, MultisourceValue::TIfAnyResolver>;
 
+/// Thread safe counterpart of FIfAnyMultisourceValue: PushValue and PopValue may be called concurrently from any
+/// thread, GetValue is wait-free. Sources are only counted, so it doesn't support OnValueChanged. Define
+/// ZKZ_ATOMIC_MULTISOURCE_TRACK_SOURCES to have active sources tracked for diagnostics, @see DumpSources.
+class FAtomicIfAnyMultisourceValue
+{
+public:
+	/// Identifies a pushed source. Move-only and reset by PopValue, so a source can't be popped twice (as long as a
+	/// single handle isn't popped from multiple threads at once).
+	class FSourceHandle
+	{
+	public:
+		FSourceHandle() = default;
+
+		FSourceHandle(FSourceHandle&& Other) : Id{Other.Id}
+		{
+			Other.Id = 0;
+		}
+
+		FSourceHandle& operator=(FSourceHandle&& Other)
+		{
+			// The overwritten source could never be popped
+			ensureMsgf(!IsSet() || this == &Other, TEXT("Overwriting the handle of source %u"), Id);
+			Id = Other.Id;
+			if (this != &Other)
+			{
+				Other.Id = 0;
+			}
+
+			return *this;
+		}
+
+		FSourceHandle(const FSourceHandle&) = delete;
+		FSourceHandle& operator=(const FSourceHandle&) = delete;
+
+		bool IsSet() const
+		{
+			return Id != 0;
+		}
+
+	private:
+		friend FAtomicIfAnyMultisourceValue;
+
+		explicit FSourceHandle(const uint32 InId) : Id{InId}
+		{
+		}
+
+		uint32 Id = 0;
+	};
+
+	FAtomicIfAnyMultisourceValue() = default;
+
+	explicit FAtomicIfAnyMultisourceValue(const bool bInDefaultValue) : bDefaultValue{bInDefaultValue}
+	{
+	}
+
+	FAtomicIfAnyMultisourceValue(const FAtomicIfAnyMultisourceValue&) = delete;
+	FAtomicIfAnyMultisourceValue& operator=(const FAtomicIfAnyMultisourceValue&) = delete;
+
+	~FAtomicIfAnyMultisourceValue()
+	{
+		const int32 NumRemainingSources = NumSources.load();
+		ensureMsgf(NumRemainingSources == 0, TEXT("Destroying multisource value with %d sources"), NumRemainingSources);
+	}
+
+	void SetDefaultValue(const bool bInDefaultValue)
+	{
+		bDefaultValue.store(bInDefaultValue, std::memory_order_release);
+	}
+
+	bool GetDefaultValue() const
+	{
+		return bDefaultValue.load(std::memory_order_acquire);
+	}
+
+	/// @param DebugName - only kept when ZKZ_ATOMIC_MULTISOURCE_TRACK_SOURCES is enabled
+	FSourceHandle PushValue([[maybe_unused]] const FName DebugName = NAME_None)
+	{
+		// Skips zero on wrap around, so that a set handle never looks unset
+		uint32 Id = LastSourceId.fetch_add(1, std::memory_order_relaxed) + 1;
+		if (Id == 0)
+		{
+			Id = LastSourceId.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+
+#if ZKZ_ATOMIC_MULTISOURCE_TRACK_SOURCES
+		{
+			FScopeLock Lock{&TrackedSourcesCriticalSection};
+			TrackedSources.Add(Id, DebugName);
+		}
+#endif
+
+		NumSources.fetch_add(1, std::memory_order_acq_rel);
+		return FSourceHandle{Id};
+	}
+
+	/// Resets the handle. Unset handles are ignored, stale ones (e.g. of another value) raise an ensure and aren't
+	/// counted.
+	void PopValue(FSourceHandle& Handle)
+	{
+		ZKZ_RETURN_IF(!Handle.IsSet());
+
+		const uint32 Id = Handle.Id;
+		Handle.Id = 0;
+
+#if ZKZ_ATOMIC_MULTISOURCE_TRACK_SOURCES
+		{
+			FScopeLock Lock{&TrackedSourcesCriticalSection};
+			ZKZ_RETURN_IF(!ensureMsgf(TrackedSources.Remove(Id) == 1, TEXT("Popping unknown source %u"), Id));
+		}
+#endif
+
+		// Never drops below zero, so that a stale handle can't make the value ignore a later source
+		int32 PrevNumSources = NumSources.load(std::memory_order_relaxed);
+		do
+		{
+			ZKZ_RETURN_IF_ENSUREMSGF(PrevNumSources <= 0, "Popped more sources than pushed");
+		} while (!NumSources.compare_exchange_weak(PrevNumSources, PrevNumSources - 1, std::memory_order_acq_rel));
+	}
+
+	bool GetValue() const
+	{
+		const bool bDefault = GetDefaultValue();
+		return NumSources.load(std::memory_order_acquire) == 0 ? bDefault : !bDefault;
+	}
+
+	int32 GetNumSources() const
+	{
+		return NumSources.load(std::memory_order_acquire);
+	}
+
+#if ZKZ_ATOMIC_MULTISOURCE_TRACK_SOURCES
+	/// Lists the debug names of all currently pushed sources.
+	void DumpSources(FOutputDevice& Output) const
+	{
+		FScopeLock Lock{&TrackedSourcesCriticalSection};
+
+		Output.Logf(TEXT("%d active sources:"), TrackedSources.Num());
+		for (const TPair<uint32, FName>& Source : TrackedSources)
+		{
+			Output.Logf(TEXT("  #%u %s"), Source.Key, *Source.Value.ToString());
+		}
+	}
+#endif
+
+private:
+	std::atomic<int32> NumSources{0};
+
+	std::atomic<uint32> LastSourceId{0};
+
+	std::atomic<bool> bDefaultValue{false};
+
+#if ZKZ_ATOMIC_MULTISOURCE_TRACK_SOURCES
+	mutable FCriticalSection TrackedSourcesCriticalSection;
+
+	TMap<uint32, FName> TrackedSources;
+#endif
+};
+
 }  // namespace Zkz
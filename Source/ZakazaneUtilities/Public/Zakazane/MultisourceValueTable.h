@@ -0,0 +1,300 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "GenerationalSlots.h"
+#include "Monostate.h"
+#include "ReturnIfMacros.h"
+
+namespace Zkz
+{
+
+namespace MultisourceValueTable
+{
+
+/// Value from the source with the highest priority wins, ties go to the most recently pushed source. Same semantics
+/// as MultisourceValue::TPriorityBasedResolver.
+template <class ValueType>
+struct TPriorityPolicy
+{
+	struct FAccumulator
+	{
+		ValueType Value{};
+
+		int32 Priority = 0;
+
+		uint32 PushOrder = 0;
+
+		bool bHasValue = false;
+	};
+
+	static FAccumulator MakeAccumulator()
+	{
+		return FAccumulator{};
+	}
+
+	static void Accumulate(
+		FAccumulator& Accumulator, const ValueType& Value, const int32 Priority, const uint32 PushOrder)
+	{
+		if (!Accumulator.bHasValue || Priority > Accumulator.Priority
+			|| (Priority == Accumulator.Priority && PushOrder > Accumulator.PushOrder))
+		{
+			Accumulator = FAccumulator{Value, Priority, PushOrder, true};
+		}
+	}
+
+	static ValueType Resolve(const FAccumulator& Accumulator, const ValueType& DefaultValue)
+	{
+		return Accumulator.bHasValue ? Accumulator.Value : DefaultValue;
+	}
+};
+
+/// All source values are summed up, priorities are ignored. Same semantics as MultisourceValue::TSumResolver.
+template <class ValueType>
+struct TSumPolicy
+{
+	using FAccumulator = ValueType;
+
+	static FAccumulator MakeAccumulator()
+	{
+		return ValueType{0};
+	}
+
+	static void Accumulate(FAccumulator& Accumulator, const ValueType& Value, int32, uint32)
+	{
+		Accumulator += Value;
+	}
+
+	static ValueType Resolve(const FAccumulator& Accumulator, const ValueType&)
+	{
+		return Accumulator;
+	}
+};
+
+}  // namespace MultisourceValueTable
+
+/// Stores many independent multisource values (e.g. a stat per AI agent) in structure-of-arrays form, instead of each
+/// value owning its own source array. Sources of all values share a single set of dense columns, and each value keeps
+/// the indices of its own sources in them.
+///
+/// Pushing and popping only marks the value dirty. ResolveDirty, meant to be called once per frame, resolves all
+/// dirty values visiting only their own sources, so the cost is paid once per frame rather than per change or per
+/// read. GetValue returns the value resolved by the last ResolveDirty.
+///
+/// Values and sources are addressed by generational handles. Stale handles are ignored.
+/// @tparam PolicyType - resolution policy, @see MultisourceValueTable::TPriorityPolicy
+template <class InValueType, class PolicyType = MultisourceValueTable::TPriorityPolicy<InValueType>>
+class TMultisourceValueTable
+{
+public:
+	using ValueType = InValueType;
+	using FValueHandle = FGenerationalHandle;
+	using FSourceHandle = FGenerationalHandle;
+
+	FValueHandle AddValue(ValueType DefaultValue)
+	{
+		const FValueHandle Handle = Values.Add(FMonostate{});
+
+		const int32 Row = Handle.Index;
+		if (Row >= DefaultValues.Num())
+		{
+			const int32 NumRows = Row + 1;
+			DefaultValues.SetNum(NumRows);
+			ResolvedValues.SetNum(NumRows);
+			RowSourceIndices.SetNum(NumRows);
+			DirtyRows.SetNum(NumRows, false);
+		}
+
+		ResolvedValues[Row] = DefaultValue;
+		DefaultValues[Row] = MoveTemp(DefaultValue);
+		DirtyRows[Row] = false;
+
+		return Handle;
+	}
+
+	/// Removes the value along with all its sources. O(number of its sources).
+	void RemoveValue(const FValueHandle Handle)
+	{
+		ZKZ_RETURN_IF(!Values.IsValid(Handle));
+
+		const int32 Row = Handle.Index;
+		while (!RowSourceIndices[Row].IsEmpty())
+		{
+			RemoveSourceAt(RowSourceIndices[Row].Last());
+		}
+
+		if (DirtyRows[Row])
+		{
+			DirtyRows[Row] = false;
+			DirtyRowIndices.RemoveSingleSwap(Row, EAllowShrinking::No);
+		}
+
+		Values.Remove(Handle);
+	}
+
+	bool IsValid(const FValueHandle Handle) const
+	{
+		return Values.IsValid(Handle);
+	}
+
+	FSourceHandle PushValue(const FValueHandle Handle, ValueType Value, const int32 Priority = 0)
+	{
+		ZKZ_RETURN_IF_ENSUREMSGF(!Values.IsValid(Handle), "Pushing to an invalid multisource value", FSourceHandle{});
+
+		const int32 SourceIdx = SourceValues.Emplace(MoveTemp(Value));
+		SourcePriorities.Emplace(Priority);
+		SourcePushOrders.Emplace(++LastPushOrder);
+		SourceRows.Emplace(Handle.Index);
+		SourceSlotsInRow.Emplace(RowSourceIndices[Handle.Index].Emplace(SourceIdx));
+
+		const FSourceHandle SourceHandle = SourceIndices.Add(SourceIdx);
+		SourceHandles.Emplace(SourceHandle);
+
+		MarkDirty(Handle.Index);
+		return SourceHandle;
+	}
+
+	void PopValue(const FSourceHandle SourceHandle)
+	{
+		const int32* const SourceIdx = SourceIndices.Find(SourceHandle);
+		ZKZ_RETURN_IF(SourceIdx == nullptr);
+
+		MarkDirty(SourceRows[*SourceIdx]);
+		RemoveSourceAt(*SourceIdx);
+	}
+
+	void SetDefaultValue(const FValueHandle Handle, ValueType DefaultValue)
+	{
+		ZKZ_RETURN_IF(!Values.IsValid(Handle));
+
+		DefaultValues[Handle.Index] = MoveTemp(DefaultValue);
+		MarkDirty(Handle.Index);
+	}
+
+	/// Returns the value as resolved by the last ResolveDirty call.
+	const ValueType& GetValue(const FValueHandle Handle) const
+	{
+		check(Values.IsValid(Handle));
+		return ResolvedValues[Handle.Index];
+	}
+
+	bool IsDirty(const FValueHandle Handle) const
+	{
+		return Values.IsValid(Handle) && DirtyRows[Handle.Index];
+	}
+
+	int32 GetNumDirty() const
+	{
+		return DirtyRowIndices.Num();
+	}
+
+	int32 GetNumSources() const
+	{
+		return SourceValues.Num();
+	}
+
+	/// Resolves all dirty values, visiting only their own sources. O(number of sources of the dirty values).
+	/// Optionally outputs handles of the values whose resolved value changed.
+	void ResolveDirty(TArray<FValueHandle>* OutChangedValues = nullptr)
+	{
+		ZKZ_RETURN_IF(DirtyRowIndices.IsEmpty());
+
+		for (const int32 Row : DirtyRowIndices)
+		{
+			typename PolicyType::FAccumulator Accumulator = PolicyType::MakeAccumulator();
+			for (const int32 SourceIdx : RowSourceIndices[Row])
+			{
+				PolicyType::Accumulate(
+					Accumulator, SourceValues[SourceIdx], SourcePriorities[SourceIdx], SourcePushOrders[SourceIdx]);
+			}
+
+			ValueType NewValue = PolicyType::Resolve(Accumulator, DefaultValues[Row]);
+			if (OutChangedValues != nullptr && !(NewValue == ResolvedValues[Row]))
+			{
+				OutChangedValues->Emplace(Values.GetHandle(Row));
+			}
+
+			ResolvedValues[Row] = MoveTemp(NewValue);
+			DirtyRows[Row] = false;
+		}
+
+		DirtyRowIndices.Reset();
+	}
+
+private:
+	void MarkDirty(const int32 Row)
+	{
+		ZKZ_RETURN_IF(DirtyRows[Row]);
+
+		DirtyRows[Row] = true;
+		DirtyRowIndices.Emplace(Row);
+	}
+
+	/// Swap-removes the source from its row and from the dense columns, fixing up the indices of the sources moved
+	/// into its places
+	void RemoveSourceAt(const int32 SourceIdx)
+	{
+		SourceIndices.Remove(SourceHandles[SourceIdx]);
+
+		TArray<int32>& RowSources = RowSourceIndices[SourceRows[SourceIdx]];
+		const int32 Slot = SourceSlotsInRow[SourceIdx];
+		RowSources.RemoveAtSwap(Slot, EAllowShrinking::No);
+		if (Slot < RowSources.Num())
+		{
+			SourceSlotsInRow[RowSources[Slot]] = Slot;
+		}
+
+		SourceValues.RemoveAtSwap(SourceIdx, EAllowShrinking::No);
+		SourcePriorities.RemoveAtSwap(SourceIdx, EAllowShrinking::No);
+		SourcePushOrders.RemoveAtSwap(SourceIdx, EAllowShrinking::No);
+		SourceRows.RemoveAtSwap(SourceIdx, EAllowShrinking::No);
+		SourceSlotsInRow.RemoveAtSwap(SourceIdx, EAllowShrinking::No);
+		SourceHandles.RemoveAtSwap(SourceIdx, EAllowShrinking::No);
+
+		if (SourceIdx < SourceHandles.Num())
+		{
+			SourceIndices[SourceHandles[SourceIdx]] = SourceIdx;
+			RowSourceIndices[SourceRows[SourceIdx]][SourceSlotsInRow[SourceIdx]] = SourceIdx;
+		}
+	}
+
+	// -- Values (rows), indexed by value handle index
+
+	/// Only used for handle validation and row reuse - the row of a value is its handle index
+	TGenerationalSlots<FMonostate> Values;
+
+	TArray<ValueType> DefaultValues;
+
+	TArray<ValueType> ResolvedValues;
+
+	/// Indices of the sources of each value in the dense source columns, unordered
+	TArray<TArray<int32>> RowSourceIndices;
+
+	TBitArray<> DirtyRows;
+
+	TArray<int32> DirtyRowIndices;
+
+	// -- Sources of all values, dense
+
+	TArray<ValueType> SourceValues;
+
+	TArray<int32> SourcePriorities;
+
+	TArray<uint32> SourcePushOrders;
+
+	TArray<int32> SourceRows;
+
+	/// Index of the source in RowSourceIndices of its row
+	TArray<int32> SourceSlotsInRow;
+
+	TArray<FSourceHandle> SourceHandles;
+
+	/// Source handle -> index in the dense source columns
+	TGenerationalSlots<int32> SourceIndices;
+
+	uint32 LastPushOrder = 0;
+};
+
+}  // namespace Zkz
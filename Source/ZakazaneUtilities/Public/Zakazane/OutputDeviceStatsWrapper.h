@@ -4,24 +4,77 @@
 
 #include "CoreMinimal.h"
 
+#include "Containers/StaticArray.h"
+
+#include <atomic>
+
 /// Wrapper for FOutputDevice implementations that collects the number of messages by verbosity. Provided wrapped output
 /// device may be null in which case the log message will not be passed on.
+///
+/// Counters are atomic, indexed by verbosity, so a single wrapper can be shared by threads serializing concurrently
+/// (e.g. parallel ImportText_Direct calls) as long as the wrapped device can, @see CanBeUsedOnMultipleThreads.
+/// Per-category counters are opt-in, they take a read lock to find the category (and a write lock the first time it's
+/// seen).
 class ZAKAZANEUTILITIES_API FOutputDeviceStatsWrapper : public FOutputDevice
 {
 public:
-	explicit FOutputDeviceStatsWrapper(FOutputDevice* InOutputDevice);
+	/// Plain copy of the counters, taken with GetSnapshot
+	struct ZAKAZANEUTILITIES_API FSnapshot
+	{
+		int32 GetNumMessages(ELogVerbosity::Type Verbosity) const;
+		int32 GetNumMessagesWorseThan(ELogVerbosity::Type Verbosity) const;
+
+		int32 GetNumMessages(FName Category, ELogVerbosity::Type Verbosity) const;
+
+		FSnapshot& operator+=(const FSnapshot& Other);
+
+		TStaticArray<int32, ELogVerbosity::NumVerbosity> NumMessagesByVerbosity{InPlace, 0};
+
+		/// Only filled in if the wrapper counts by category
+		TMap<FName, TStaticArray<int32, ELogVerbosity::NumVerbosity>> NumMessagesByCategory;
+	};
+
+	explicit FOutputDeviceStatsWrapper(FOutputDevice* InOutputDevice, bool bInCountByCategory = false);
 
 	virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category) override;
 	virtual void Serialize(
 		const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category, const double Time) override;
 
+	/// True if there's no wrapped output device or it can be used on multiple threads
+	virtual bool CanBeUsedOnMultipleThreads() const override;
+
 	int32 GetNumMessages(ELogVerbosity::Type Verbosity) const;
 	int32 GetNumMessagesWorseThan(ELogVerbosity::Type Verbosity) const;
 
+	/// Zero if the wrapper doesn't count by category
+	int32 GetNumMessages(FName Category, ELogVerbosity::Type Verbosity) const;
+
+	/// Copy of the counters. Messages serialized concurrently may or may not be included.
+	FSnapshot GetSnapshot() const;
+
+	/// Adds the counts of the snapshot (e.g. of a per-thread wrapper) to this wrapper's counters
+	void Merge(const FSnapshot& Snapshot);
+
+	void Reset();
+
 private:
+	struct FCounters
+	{
+		std::atomic<int32> NumMessages[ELogVerbosity::NumVerbosity]{};
+	};
+
 	FOutputDevice* const OutputDevice = nullptr;
 
-	TMap<ELogVerbosity::Type, int32, TInlineSetAllocator<ELogVerbosity::NumVerbosity>> NumMessagesByVerbosity;
+	const bool bCountByCategory = false;
+
+	FCounters TotalCounters;
+
+	/// Counters are never removed, only reset, so the pointers stay valid without holding the lock
+	TMap<FName, TUniquePtr<FCounters>> NumMessagesByCategory;
+
+	mutable FRWLock CategoryLock;
+
+	FCounters& FindOrAddCategoryCounters(FName Category);
 
-	void IncrementNumMessages(ELogVerbosity::Type Verbosity);
+	void IncrementNumMessages(ELogVerbosity::Type Verbosity, const FName& Category);
 };
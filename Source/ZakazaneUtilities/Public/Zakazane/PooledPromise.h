@@ -0,0 +1,313 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Containers/LockFreeFixedSizeAllocator.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "ReturnIfMacros.h"
+
+#include <atomic>
+
+namespace Zkz
+{
+
+template <class T>
+class TPooledPromise;
+
+template <class T>
+class TPooledFuture;
+
+namespace PooledPromisePrivate
+{
+
+/// Shared state of a TPooledPromise / TPooledFuture pair. Kept alive by a reference count and returned to a per-type
+/// pool (rather than freed) when the last reference is gone.
+template <class T>
+class TPooledFutureState
+{
+public:
+	static TPooledFutureState* Create();
+
+	void AddRef()
+	{
+		NumRefs.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void Release();
+
+	bool IsReady() const
+	{
+		return (Flags.load(std::memory_order_acquire) & HasValueFlag) != 0;
+	}
+
+	/// Must only be called when IsReady.
+	T GetValue() const
+	{
+		return *Value.GetTypedPtr();
+	}
+
+	void SetValue(const T InValue)
+	{
+		new (Value.GetTypedPtr()) T{InValue};
+
+		// Whoever comes second - value or continuation - invokes the continuation
+		const uint8 PreviousFlags = Flags.fetch_or(HasValueFlag, std::memory_order_acq_rel);
+		ensureMsgf((PreviousFlags & HasValueFlag) == 0, TEXT("Pooled promise value set more than once"));
+
+		if ((PreviousFlags & HasContinuationFlag) != 0)
+		{
+			InvokeContinuation();
+		}
+	}
+
+	void SetContinuation(TUniqueFunction<void(T)>&& InContinuation)
+	{
+		Continuation = MoveTemp(InContinuation);
+
+		const uint8 PreviousFlags = Flags.fetch_or(HasContinuationFlag, std::memory_order_acq_rel);
+		ensureMsgf((PreviousFlags & HasContinuationFlag) == 0, TEXT("Pooled future continuation set more than once"));
+
+		if ((PreviousFlags & HasValueFlag) != 0)
+		{
+			InvokeContinuation();
+		}
+	}
+
+private:
+	static constexpr uint8 HasValueFlag = 1 << 0;
+	static constexpr uint8 HasContinuationFlag = 1 << 1;
+
+	TPooledFutureState() = default;
+
+	void InvokeContinuation()
+	{
+		TUniqueFunction<void(T)> InvokedContinuation = MoveTemp(Continuation);
+		InvokedContinuation(GetValue());
+	}
+
+	std::atomic<int32> NumRefs{1};
+	std::atomic<uint8> Flags{0};
+
+	TTypeCompatibleBytes<T> Value;
+
+	/// Empty (and not allocating) unless TPooledFuture::Next is used
+	TUniqueFunction<void(T)> Continuation;
+};
+
+template <class T>
+using TPooledFutureStateAllocator =
+	TLockFreeFixedSizeAllocator<sizeof(TPooledFutureState<T>), PLATFORM_CACHE_LINE_SIZE, FThreadSafeCounter>;
+
+template <class T>
+TPooledFutureStateAllocator<T>& GetPooledFutureStateAllocator()
+{
+	static TPooledFutureStateAllocator<T> Allocator;
+	return Allocator;
+}
+
+template <class T>
+TPooledFutureState<T>* TPooledFutureState<T>::Create()
+{
+	void* const Memory = GetPooledFutureStateAllocator<T>().Allocate();
+	return new (Memory) TPooledFutureState{};
+}
+
+template <class T>
+void TPooledFutureState<T>::Release()
+{
+	if (NumRefs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		this->~TPooledFutureState();
+		GetPooledFutureStateAllocator<T>().Free(this);
+	}
+}
+
+}  // namespace PooledPromisePrivate
+
+/// Promise for small, trivially copyable values (bools, ints, handles), for use where many short-lived promises are
+/// created per frame. Unlike TPromise, the shared state is recycled through a lock-free per-type pool, so after warm-up
+/// creating a promise / future pair doesn't allocate. Like TScopedPromise, the promise sets the given cancelled value
+/// when destroyed without being fulfilled.
+template <class T>
+class TPooledPromise
+{
+	static_assert(std::is_trivially_copyable_v<T>, "TPooledPromise only supports trivially copyable values");
+
+public:
+	explicit TPooledPromise(const T InCancelledValue)
+		: State{PooledPromisePrivate::TPooledFutureState<T>::Create()}, CancelledValue{InCancelledValue}
+	{
+	}
+
+	TPooledPromise(const TPooledPromise&) = delete;
+	TPooledPromise& operator=(const TPooledPromise&) = delete;
+
+	TPooledPromise(TPooledPromise&& Other)
+		: State{Other.State}
+		, CancelledValue{Other.CancelledValue}
+		, bFulfilled{Other.bFulfilled}
+		, bFutureRetrieved{Other.bFutureRetrieved}
+	{
+		Other.State = nullptr;
+	}
+
+	TPooledPromise& operator=(TPooledPromise&& Other)
+	{
+		ZKZ_RETURN_IF(this == &Other, *this);
+
+		Reset();
+
+		State = Other.State;
+		CancelledValue = Other.CancelledValue;
+		bFulfilled = Other.bFulfilled;
+		bFutureRetrieved = Other.bFutureRetrieved;
+
+		Other.State = nullptr;
+		return *this;
+	}
+
+	~TPooledPromise()
+	{
+		Reset();
+	}
+
+	void SetValue(const T Value)
+	{
+		ZKZ_RETURN_IF_ENSUREMSGF(State == nullptr || bFulfilled, "Pooled promise is invalid or already fulfilled");
+
+		bFulfilled = true;
+		State->SetValue(Value);
+	}
+
+	/// May be called only once.
+	TPooledFuture<T> GetFuture()
+	{
+		ZKZ_RETURN_IF_ENSUREMSGF(State == nullptr || bFutureRetrieved, "Pooled future already retrieved", {});
+
+		bFutureRetrieved = true;
+		State->AddRef();
+		return TPooledFuture<T>{State};
+	}
+
+	/// Total number of shared states allocated for this value type: both in use and waiting in the pool.
+	static int32 GetNumAllocatedStates()
+	{
+		auto& Allocator = PooledPromisePrivate::GetPooledFutureStateAllocator<T>();
+		return Allocator.GetNumUsed().GetValue() + Allocator.GetNumFree().GetValue();
+	}
+
+private:
+	void Reset()
+	{
+		ZKZ_RETURN_IF(State == nullptr);
+
+		if (!bFulfilled)
+		{
+			SetValue(CancelledValue);
+		}
+
+		State->Release();
+		State = nullptr;
+	}
+
+	PooledPromisePrivate::TPooledFutureState<T>* State = nullptr;
+
+	T CancelledValue;
+
+	bool bFulfilled = false;
+
+	bool bFutureRetrieved = false;
+};
+
+/// Future counterpart of TPooledPromise. Single consumer: the value is either polled (IsReady / TryGet / Get) or passed
+/// to a single continuation set with Next.
+template <class T>
+class TPooledFuture
+{
+public:
+	TPooledFuture() = default;
+
+	TPooledFuture(const TPooledFuture&) = delete;
+	TPooledFuture& operator=(const TPooledFuture&) = delete;
+
+	TPooledFuture(TPooledFuture&& Other) : State{Other.State}
+	{
+		Other.State = nullptr;
+	}
+
+	TPooledFuture& operator=(TPooledFuture&& Other)
+	{
+		ZKZ_RETURN_IF(this == &Other, *this);
+
+		Reset();
+		State = Other.State;
+		Other.State = nullptr;
+		return *this;
+	}
+
+	~TPooledFuture()
+	{
+		Reset();
+	}
+
+	bool IsValid() const
+	{
+		return State != nullptr;
+	}
+
+	bool IsReady() const
+	{
+		return State != nullptr && State->IsReady();
+	}
+
+	TOptional<T> TryGet() const
+	{
+		return IsReady() ? TOptional<T>{State->GetValue()} : TOptional<T>{};
+	}
+
+	/// Busy-waits until the value is set. Meant for values known to be set shortly (e.g. by a parallel job) - prefer
+	/// polling or Next otherwise.
+	T Get() const
+	{
+		check(State != nullptr);
+
+		while (!State->IsReady())
+		{
+			FPlatformProcess::Yield();
+		}
+
+		return State->GetValue();
+	}
+
+	/// Sets a continuation called with the value once it's set - immediately if it's already set. The continuation
+	/// is called on the thread setting the value. Invalidates this future.
+	template <class ContinuationType>
+	void Next(ContinuationType&& Continuation)
+	{
+		ZKZ_RETURN_IF_ENSUREMSGF(State == nullptr, "Next called on invalid pooled future");
+
+		State->SetContinuation(TUniqueFunction<void(T)>{Forward<ContinuationType>(Continuation)});
+		Reset();
+	}
+
+private:
+	friend class TPooledPromise<T>;
+
+	explicit TPooledFuture(PooledPromisePrivate::TPooledFutureState<T>* InState) : State{InState}
+	{
+	}
+
+	void Reset()
+	{
+		ZKZ_RETURN_IF(State == nullptr);
+
+		State->Release();
+		State = nullptr;
+	}
+
+	PooledPromisePrivate::TPooledFutureState<T>* State = nullptr;
+};
+
+}  // namespace Zkz
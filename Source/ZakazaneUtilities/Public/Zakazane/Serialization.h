@@ -21,6 +21,19 @@ enum class EImportResult
 	Success,
 };
 
+enum class EImportFlags : uint8
+{
+	None = 0,
+	/// Converts rows on worker threads, in batches. Falls back to the calling thread if the struct has object
+	/// references, as importing them may find or load objects. Messages are the same as without the flag, logged on
+	/// the calling thread in row order.
+	Parallel = 1 << 0,
+	/// With Parallel, the line callback is called on worker threads as soon as a row is converted, in no particular
+	/// order. The callback has to be thread safe.
+	UnorderedCallback = 1 << 1,
+};
+ENUM_CLASS_FLAGS(EImportFlags)
+
 /// Exports objects of a given type to CSV. Current implementation only handles FText properties in a special
 /// manner (extracting the underlying string) and exports other types using the generic ExportText_Direct function.
 /// Doesn't support containers at the moment. Add handling other property types (and/or containers) as necessary.
@@ -55,33 +68,41 @@ FString ExportToCSV(const TArrayView<const T> Objects)
 /// @param LineCallback - callback function called for each imported object
 /// @param Output - optional output device for gathering error messages
 /// @param SlowTask - optional slow task to be ticked as task progresses. All import work sums up to 1.0f.
+/// @param Flags - @see EImportFlags
 ZAKAZANEUTILITIES_API EImportResult ImportFromCSV(
 	const UStruct& Struct,
 	const FString& CSV,
 	const TFunction<void(const void*)>& LineCallback,
 	FOutputDevice* Output = nullptr,
-	FSlowTask* SlowTask = nullptr);
+	FSlowTask* SlowTask = nullptr,
+	EImportFlags Flags = EImportFlags::None);
 
 /// @see ImportFromCSV(
 /// 	const UStruct& Struct,
 /// 	const FString& CSV,
 /// 	const TFunction<void(const void*)>& LineCallback,
 /// 	FOutputDevice* Output = nullptr,
-/// 	FSlowTask* SlowTask = nullptr)
+/// 	FSlowTask* SlowTask = nullptr,
+/// 	EImportFlags Flags = EImportFlags::None)
 ///
 /// Templated version for objects of known type.
 template <
 	class T,
 	class LineCallbackType UE_REQUIRES(TIsUHTUStruct_v<T>&& TIsInvocable<LineCallbackType, const T&>::Value)>
 EImportResult ImportFromCSV(
-	const FString& CSV, LineCallbackType&& LineCallback, FOutputDevice* Output = nullptr, FSlowTask* SlowTask = nullptr)
+	const FString& CSV,
+	LineCallbackType&& LineCallback,
+	FOutputDevice* Output = nullptr,
+	FSlowTask* SlowTask = nullptr,
+	EImportFlags Flags = EImportFlags::None)
 {
 	return ImportFromCSV(
 		*T::StaticStruct(),
 		CSV,
 		[&LineCallback](const void* const Data) { LineCallback(*static_cast<const T*>(Data)); },
 		Output,
-		SlowTask);
+		SlowTask,
+		Flags);
 }
 
 }  // namespace Zkz::Serialization
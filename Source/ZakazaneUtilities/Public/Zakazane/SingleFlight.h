@@ -0,0 +1,256 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Future.h"
+#include "Misc/ScopeLock.h"
+#include "ReturnIfMacros.h"
+
+namespace Zkz
+{
+
+struct FSingleFlightCachePolicy
+{
+	/// How long (in seconds) a produced value is kept and handed out to subsequent requests for the same key.
+	/// Non-positive value disables caching - only requests made while the value is being produced are coalesced.
+	double TimeToLive = 0.0;
+
+	/// Maximum number of cached values. When exceeded, expired values are dropped first and then the value closest to
+	/// expiring is evicted. Non-positive value means the cache is unbounded.
+	int32 MaxNumCachedValues = 0;
+};
+
+/// Coalesces concurrent requests for the same key into a single asynchronous computation. The first request for a key
+/// invokes the producer, any requests made before the produced future is fulfilled receive a future of the same
+/// value instead of invoking their own producers. Optionally keeps produced values cached for a given time.
+///
+/// Thread safe. If destroyed while values are still being produced, the waiting futures are fulfilled with the
+/// cancelled value passed to the constructor.
+///
+/// Usage:
+/// @code
+/// TSingleFlight<FName, FPathResult> PathQueries{FPathResult{}};
+/// TFuture<FPathResult> Path = PathQueries.Request(QueryName, [&] { return RunPathQueryAsync(QueryName); });
+/// @endcode
+template <class KeyType, class ValueType>
+class TSingleFlight
+{
+public:
+	explicit TSingleFlight(ValueType InCancelledValue, const FSingleFlightCachePolicy& InCachePolicy = {})
+		: State{MakeShared<FState, ESPMode::ThreadSafe>(MoveTemp(InCancelledValue), InCachePolicy)}
+	{
+	}
+
+	/// Returns a future of the value for the given key. Producer - a function returning TFuture<ValueType> - is only
+	/// invoked if the value is neither cached nor already being produced. Producer is invoked on the calling thread,
+	/// outside any locks.
+	template <class ProducerType>
+	TFuture<ValueType> Request(const KeyType& Key, ProducerType&& Producer)
+	{
+		TFuture<ValueType> Future;
+
+		{
+			FScopeLock Lock{&State->CriticalSection};
+
+			if (const FCacheEntry* const CacheEntry = State->FindCached(Key))
+			{
+				return MakeFulfilledPromise<ValueType>(CacheEntry->Value).GetFuture();
+			}
+
+			if (FInFlightEntry* const InFlightEntry = State->InFlight.Find(Key))
+			{
+				return InFlightEntry->Waiters.Emplace_GetRef(AsConst(State->CancelledValue)).GetFuture();
+			}
+
+			FInFlightEntry& NewEntry = State->InFlight.Add(Key);
+			Future = NewEntry.Waiters.Emplace_GetRef(AsConst(State->CancelledValue)).GetFuture();
+		}
+
+		::Invoke(Forward<ProducerType>(Producer))
+			.Next(
+				[WeakState = TWeakPtr<FState, ESPMode::ThreadSafe>{State},
+				 Key]<class ProducedValueType>(ProducedValueType&& Value)
+				{
+					if (const TSharedPtr<FState, ESPMode::ThreadSafe> PinnedState = WeakState.Pin())
+					{
+						PinnedState->Complete(Key, Forward<ProducedValueType>(Value));
+					}
+				});
+
+		return Future;
+	}
+
+	bool IsInFlight(const KeyType& Key) const
+	{
+		FScopeLock Lock{&State->CriticalSection};
+		return State->InFlight.Contains(Key);
+	}
+
+	/// Drops the cached value for the given key. If the value is currently being produced, it will still be passed to
+	/// the waiting futures, but won't be cached.
+	void Invalidate(const KeyType& Key)
+	{
+		FScopeLock Lock{&State->CriticalSection};
+
+		State->Cache.Remove(Key);
+		if (FInFlightEntry* const InFlightEntry = State->InFlight.Find(Key))
+		{
+			InFlightEntry->bInvalidated = true;
+		}
+	}
+
+	/// Drops all cached values. Values currently being produced won't be cached.
+	void InvalidateAll()
+	{
+		FScopeLock Lock{&State->CriticalSection};
+
+		State->Cache.Empty();
+		for (TPair<KeyType, FInFlightEntry>& InFlightPair : State->InFlight)
+		{
+			InFlightPair.Value.bInvalidated = true;
+		}
+	}
+
+	/// Drops all expired cached values. Expired values are also dropped lazily when requested, so calling this is only
+	/// needed to release memory.
+	void EvictExpired()
+	{
+		FScopeLock Lock{&State->CriticalSection};
+		State->EvictExpired(FPlatformTime::Seconds());
+	}
+
+	int32 GetNumCachedValues() const
+	{
+		FScopeLock Lock{&State->CriticalSection};
+		return State->Cache.Num();
+	}
+
+private:
+	struct FInFlightEntry
+	{
+		TArray<TScopedPromise<ValueType>, TInlineAllocator<1>> Waiters;
+
+		bool bInvalidated = false;
+	};
+
+	struct FCacheEntry
+	{
+		ValueType Value;
+
+		double ExpirationTime = 0.0;
+	};
+
+	struct FState
+	{
+		FState(ValueType&& InCancelledValue, const FSingleFlightCachePolicy& InCachePolicy)
+			: CancelledValue{MoveTemp(InCancelledValue)}, CachePolicy{InCachePolicy}
+		{
+		}
+
+		/// Must be called with CriticalSection locked
+		const FCacheEntry* FindCached(const KeyType& Key)
+		{
+			const FCacheEntry* const CacheEntry = Cache.Find(Key);
+			ZKZ_RETURN_IF(CacheEntry == nullptr, nullptr);
+
+			if (CacheEntry->ExpirationTime <= FPlatformTime::Seconds())
+			{
+				Cache.Remove(Key);
+				return nullptr;
+			}
+
+			return CacheEntry;
+		}
+
+		/// Must be called with CriticalSection locked
+		void EvictExpired(const double Now)
+		{
+			for (auto It = Cache.CreateIterator(); It; ++It)
+			{
+				if (It->Value.ExpirationTime <= Now)
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+
+		/// Must be called with CriticalSection locked
+		void AddToCache(const KeyType& Key, const ValueType& Value)
+		{
+			const double Now = FPlatformTime::Seconds();
+
+			if (CachePolicy.MaxNumCachedValues > 0 && Cache.Num() >= CachePolicy.MaxNumCachedValues
+				&& !Cache.Contains(Key))
+			{
+				EvictExpired(Now);
+			}
+
+			if (CachePolicy.MaxNumCachedValues > 0 && Cache.Num() >= CachePolicy.MaxNumCachedValues
+				&& !Cache.Contains(Key))
+			{
+				// All entries share the same time to live, so the one closest to expiring is the oldest one. Linear
+				// search is fine here, as it only happens when adding to a full cache.
+				const KeyType* OldestKey = nullptr;
+				double OldestExpirationTime = TNumericLimits<double>::Max();
+				for (const TPair<KeyType, FCacheEntry>& CachePair : Cache)
+				{
+					if (CachePair.Value.ExpirationTime < OldestExpirationTime)
+					{
+						OldestKey = &CachePair.Key;
+						OldestExpirationTime = CachePair.Value.ExpirationTime;
+					}
+				}
+
+				if (OldestKey != nullptr)
+				{
+					Cache.Remove(KeyType{*OldestKey});
+				}
+			}
+
+			Cache.Add(Key, FCacheEntry{Value, Now + CachePolicy.TimeToLive});
+		}
+
+		template <class ProducedValueType>
+		void Complete(const KeyType& Key, ProducedValueType&& Value)
+		{
+			FInFlightEntry Entry;
+
+			{
+				FScopeLock Lock{&CriticalSection};
+
+				FInFlightEntry* const FoundEntry = InFlight.Find(Key);
+				ZKZ_RETURN_IF(FoundEntry == nullptr);
+
+				Entry = MoveTemp(*FoundEntry);
+				InFlight.Remove(Key);
+
+				if (CachePolicy.TimeToLive > 0.0 && !Entry.bInvalidated)
+				{
+					AddToCache(Key, Value);
+				}
+			}
+
+			// Fulfilled outside the lock, as continuations of the waiting futures may request values again
+			for (TScopedPromise<ValueType>& Waiter : Entry.Waiters)
+			{
+				Waiter.SetValue(AsConst(Value));
+			}
+		}
+
+		mutable FCriticalSection CriticalSection;
+
+		TMap<KeyType, FInFlightEntry> InFlight;
+
+		TMap<KeyType, FCacheEntry> Cache;
+
+		const ValueType CancelledValue;
+
+		const FSingleFlightCachePolicy CachePolicy;
+	};
+
+	TSharedRef<FState, ESPMode::ThreadSafe> State;
+};
+
+}  // namespace Zkz
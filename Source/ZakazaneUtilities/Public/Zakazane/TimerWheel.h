@@ -0,0 +1,104 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Containers/Ticker.h"
+
+namespace Zkz
+{
+
+/// Hierarchical timer wheel. Schedules callbacks to be called after a given delay, quantized to the tick interval.
+/// Scheduling is O(1) and advancing time costs O(1) per tick plus the number of expired (or cascaded) timers, no
+/// matter how many timers are pending. This makes it fit for thousands of timers which mostly don't fire or fire
+/// far apart, e.g. timeouts.
+///
+/// The wheel has NumLevels levels of NumSlots slots each. Level 0 slots are one tick wide, each next level slot spans
+/// a whole lower level. Timers are put in the lowest level able to hold them and moved (cascaded) to lower levels when
+/// their slot comes up. Timers further away than the top level are kept aside and re-placed once per top level cycle.
+///
+/// Not thread safe. @see FSharedTimerWheel for the thread safe, globally ticked instance.
+class ZAKAZANEUTILITIES_API FTimerWheel
+{
+public:
+	using FCallback = TUniqueFunction<void()>;
+
+	explicit FTimerWheel(double InTickInterval = 1.0 / 60.0);
+
+	/// Schedules the callback to be called after the given delay (in seconds). The delay is rounded up to whole ticks,
+	/// and always lasts at least one tick.
+	void Schedule(double Delay, FCallback&& Callback);
+
+	/// Advances time by the given delta, calling all expired callbacks, in order of expiration.
+	void Advance(double DeltaTime);
+
+	/// Advances time by the given delta, moving expired callbacks to OutExpiredCallbacks (in order of expiration)
+	/// rather than calling them. Useful when the callbacks need to be called outside a lock.
+	void Advance(double DeltaTime, TArray<FCallback>& OutExpiredCallbacks);
+
+	int32 GetNumPending() const;
+
+	double GetTickInterval() const;
+
+private:
+	static constexpr int32 NumLevels = 4;
+	static constexpr int32 SlotBits = 6;
+	static constexpr int32 NumSlots = 1 << SlotBits;
+	static constexpr uint64 SlotMask = NumSlots - 1;
+
+	struct FTimer
+	{
+		uint64 ExpirationTick = 0;
+
+		FCallback Callback;
+	};
+
+	using FSlot = TArray<FTimer>;
+
+	void Place(FTimer&& Timer);
+
+	void Tick(TArray<FCallback>& OutExpiredCallbacks);
+
+	void Cascade(FSlot& Slot);
+
+	double TickInterval = 0.0;
+
+	double AccumulatedTime = 0.0;
+
+	uint64 CurrentTick = 0;
+
+	int32 NumPending = 0;
+
+	TStaticArray<TStaticArray<FSlot, NumSlots>, NumLevels> Levels;
+
+	/// Timers not fitting in the top level
+	FSlot Overflow;
+};
+
+/// Global thread safe timer wheel, advanced once per frame by the core ticker. Callbacks are called on the game
+/// thread. Meant for code needing lots of cheap, coarse timers (e.g. future timeouts) without registering a ticker or
+/// a timer manager timer each.
+class ZAKAZANEUTILITIES_API FSharedTimerWheel
+{
+public:
+	static FSharedTimerWheel& Get();
+
+	/// Thread safe. @see FTimerWheel::Schedule
+	void Schedule(double Delay, FTimerWheel::FCallback&& Callback);
+
+	int32 GetNumPending() const;
+
+private:
+	FSharedTimerWheel() = default;
+
+	bool Tick(float DeltaTime);
+
+	mutable FCriticalSection CriticalSection;
+
+	FTimerWheel TimerWheel;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
+
+}  // namespace Zkz
@@ -0,0 +1,234 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "GenerationalSlots.h"
+#include "ReturnIfMacros.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ZkzInterpolationSubsystem.generated.h"
+
+namespace Zkz::InterpolationPrivate
+{
+
+/// Interpolated values of a single type, stored as dense parallel arrays. Values in motion are kept at the front
+/// ([0, NumInMotion)), settled ones (current == target) at the back, so the update only walks the values in motion.
+/// Values move between the partitions by swapping, handles map to the dense indices.
+template <class ValueType>
+struct TInterpolationChannel
+{
+	/// New values start settled, as current == target
+	FGenerationalHandle Add(const ValueType& Value, const float InterpSpeed)
+	{
+		const int32 DenseIdx = Current.Emplace(Value);
+		Target.Emplace(Value);
+		InterpSpeeds.Emplace(InterpSpeed);
+
+		const FGenerationalHandle Handle = DenseIndices.Add(DenseIdx);
+		Handles.Emplace(Handle);
+		return Handle;
+	}
+
+	void Remove(const FGenerationalHandle Handle)
+	{
+		const int32* const DenseIdxPtr = DenseIndices.Find(Handle);
+		ZKZ_RETURN_IF(DenseIdxPtr == nullptr);
+
+		// Moves the value to the very end, keeping the partitions intact, then pops it
+		int32 DenseIdx = *DenseIdxPtr;
+		if (DenseIdx < NumInMotion)
+		{
+			Settle(DenseIdx);
+			DenseIdx = NumInMotion;
+		}
+
+		Swap(DenseIdx, Num() - 1);
+
+		Current.Pop(EAllowShrinking::No);
+		Target.Pop(EAllowShrinking::No);
+		InterpSpeeds.Pop(EAllowShrinking::No);
+		Handles.Pop(EAllowShrinking::No);
+		DenseIndices.Remove(Handle);
+	}
+
+	const int32* Find(const FGenerationalHandle Handle) const
+	{
+		return DenseIndices.Find(Handle);
+	}
+
+	int32 Num() const
+	{
+		return Current.Num();
+	}
+
+	bool IsInMotion(const int32 DenseIdx) const
+	{
+		return DenseIdx < NumInMotion;
+	}
+
+	/// Moves a settled value to the values in motion. Returns the new dense index.
+	int32 Wake(const int32 DenseIdx)
+	{
+		ZKZ_RETURN_IF(IsInMotion(DenseIdx), DenseIdx);
+
+		const int32 NewIdx = NumInMotion++;
+		Swap(DenseIdx, NewIdx);
+		return NewIdx;
+	}
+
+	/// Moves a value in motion to the settled ones. Returns the new dense index.
+	int32 Settle(const int32 DenseIdx)
+	{
+		ZKZ_RETURN_IF(!IsInMotion(DenseIdx), DenseIdx);
+
+		const int32 NewIdx = --NumInMotion;
+		Swap(DenseIdx, NewIdx);
+		return NewIdx;
+	}
+
+	/// Settles all values in motion which reached their target, outputting their handles
+	template <class AllocatorType>
+	void SettleArrived(TArray<FGenerationalHandle, AllocatorType>& OutArrived)
+	{
+		// Backwards, so that the value swapped into the current index has already been checked
+		for (int32 DenseIdx = NumInMotion - 1; DenseIdx >= 0; --DenseIdx)
+		{
+			if (Current[DenseIdx] == Target[DenseIdx])
+			{
+				OutArrived.Emplace(Handles[DenseIdx]);
+				Settle(DenseIdx);
+			}
+		}
+	}
+
+	void Swap(const int32 A, const int32 B)
+	{
+		ZKZ_RETURN_IF(A == B);
+
+		Current.Swap(A, B);
+		Target.Swap(A, B);
+		InterpSpeeds.Swap(A, B);
+		Handles.Swap(A, B);
+
+		DenseIndices[Handles[A]] = A;
+		DenseIndices[Handles[B]] = B;
+	}
+
+	TArray<ValueType> Current;
+
+	TArray<ValueType> Target;
+
+	TArray<float> InterpSpeeds;
+
+	/// Handle of each dense value, to fix up the handle mapping when values are swapped
+	TArray<FGenerationalHandle> Handles;
+
+	TGenerationalSlots<int32> DenseIndices;
+
+	int32 NumInMotion = 0;
+};
+
+}  // namespace Zkz::InterpolationPrivate
+
+/// Updates many interpolated values in one batch per frame, instead of each owner ticking its own
+/// FZkzInterpolatedFloatValue / FZkzInterpolatedVectorValue / FZkzInterpolatedQuatValue. Values are registered by
+/// handle, their owners set targets and read the current values, which are updated with the same frame-rate
+/// independent semantics as the structs, @see Zkz::Interpolation::TExponentialPolicy. Non-positive interp speed snaps
+/// straight to the target.
+///
+/// Values are stored in dense arrays per type. Floats are updated four at a time with SIMD, vectors and quats in
+/// tight loops over contiguous memory. Values which reached their target are settled and cost nothing per frame until
+/// they're given a new target.
+UCLASS()
+class ZAKAZANEUTILITIES_API UZkzInterpolationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	using FHandle = Zkz::FGenerationalHandle;
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnArrived, FHandle /*Handle*/);
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/// Advances all registered values by the given time. Called automatically every frame, exposed for tests and for
+	/// worlds which don't tick.
+	void UpdateAll(float DeltaTime);
+
+	/// Number of values of all types which haven't reached their target yet
+	int32 GetNumInMotion() const;
+
+	// -- Float
+
+	FHandle AddFloat(float Value, float InterpSpeed);
+
+	void RemoveFloat(FHandle Handle);
+
+	/// Sets both current and target value
+	void ResetFloat(FHandle Handle, float Value);
+
+	/// Wakes the value for any target, even the current value, which then settles (and broadcasts OnFloatArrived) on
+	/// the next UpdateAll, same as FZkzInterpolatedFloatValue.
+	void SetFloatTarget(FHandle Handle, float Target);
+
+	void SetFloatInterpSpeed(FHandle Handle, float InterpSpeed);
+
+	float GetFloat(FHandle Handle) const;
+
+	bool IsFloatSettled(FHandle Handle) const;
+
+	/// Called from UpdateAll when a float value reaches its target
+	FOnArrived OnFloatArrived;
+
+	// -- Vector
+
+	FHandle AddVector(const FVector& Value, float InterpSpeed);
+
+	void RemoveVector(FHandle Handle);
+
+	/// Sets both current and target value
+	void ResetVector(FHandle Handle, const FVector& Value);
+
+	/// @see SetFloatTarget
+	void SetVectorTarget(FHandle Handle, const FVector& Target);
+
+	void SetVectorInterpSpeed(FHandle Handle, float InterpSpeed);
+
+	FVector GetVector(FHandle Handle) const;
+
+	bool IsVectorSettled(FHandle Handle) const;
+
+	/// Called from UpdateAll when a vector value reaches its target
+	FOnArrived OnVectorArrived;
+
+	// -- Quat
+
+	FHandle AddQuat(const FQuat& Value, float InterpSpeed);
+
+	void RemoveQuat(FHandle Handle);
+
+	/// Sets both current and target value
+	void ResetQuat(FHandle Handle, const FQuat& Value);
+
+	/// @see SetFloatTarget
+	void SetQuatTarget(FHandle Handle, const FQuat& Target);
+
+	void SetQuatInterpSpeed(FHandle Handle, float InterpSpeed);
+
+	FQuat GetQuat(FHandle Handle) const;
+
+	bool IsQuatSettled(FHandle Handle) const;
+
+	/// Called from UpdateAll when a quat value reaches its target
+	FOnArrived OnQuatArrived;
+
+private:
+	Zkz::InterpolationPrivate::TInterpolationChannel<float> Floats;
+
+	Zkz::InterpolationPrivate::TInterpolationChannel<FVector> Vectors;
+
+	Zkz::InterpolationPrivate::TInterpolationChannel<FQuat> Quats;
+};
@@ -0,0 +1,320 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Net/Serialization/FastArraySerializer.h"
+
+#include "ZkzMultisourceValue.generated.h"
+
+/// Blueprint exposed counterparts of Zkz::TMultisourceValue. Sources are kept in a fast array, so when used as a
+/// replicated property only the sources added, changed or removed since the last update are sent, no matter how many
+/// sources there are. Resolver and default value are configuration - they are not replicated and are expected to be
+/// the same on all machines (e.g. set in class defaults).
+///
+/// Unlike the C++ resolvers, these resolve with a linear scan over the sources (only when they change), as they're
+/// meant for the handful of sources a designer set up rather than thousands.
+
+/// How the sources of a multisource value resolve to a single value. @see Zkz::MultisourceValue resolvers
+UENUM(BlueprintType)
+enum class EZkzMultisourceResolver : uint8
+{
+	/// Value of the source with the highest priority, the most recently pushed one on ties
+	Priority,
+	/// Sum of all sources
+	Sum,
+	/// Product of all sources
+	Product,
+	/// The lowest source value
+	Min,
+	/// The highest source value
+	Max,
+};
+
+/// Identifies a source pushed to a multisource value.
+USTRUCT(BlueprintType, Category = "Zakazane", DisplayName = "Multisource Value Source Handle")
+struct ZAKAZANEUTILITIES_API FZkzMultisourceSourceHandle
+{
+	GENERATED_BODY()
+
+	bool IsSet() const
+	{
+		return Id != 0;
+	}
+
+	UPROPERTY()
+	int32 Id = 0;
+};
+
+USTRUCT()
+struct ZAKAZANEUTILITIES_API FZkzMultisourceFloatSource : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Id = 0;
+
+	UPROPERTY()
+	int32 Priority = 0;
+
+	/// Breaks priority ties in favour of the most recently pushed source. Unlike ids, never wraps around.
+	UPROPERTY()
+	int64 PushOrder = 0;
+
+	UPROPERTY()
+	float Value = 0.0f;
+};
+
+USTRUCT(BlueprintType, Category = "Zakazane", DisplayName = "Multisource Float")
+struct ZAKAZANEUTILITIES_API FZkzMultisourceFloat : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnValueChanged, float /*NewValue*/);
+
+	FZkzMultisourceFloat() = default;
+
+	FZkzMultisourceFloat(EZkzMultisourceResolver InResolver, float InDefaultValue);
+
+	FZkzMultisourceSourceHandle PushValue(float Value, int32 Priority = 0);
+
+	void PopValue(FZkzMultisourceSourceHandle& Handle);
+
+	float GetValue() const;
+
+	void SetDefaultValue(float InDefaultValue);
+
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams);
+
+	void PostSerialize(const FArchive& Ar);
+
+	/// Called on both server and clients whenever the resolved value changes
+	FOnValueChanged OnValueChanged;
+
+private:
+	void Resolve();
+
+	UPROPERTY(EditAnywhere, meta = (AllowPrivateAccess))
+	EZkzMultisourceResolver Resolver = EZkzMultisourceResolver::Priority;
+
+	UPROPERTY(EditAnywhere, meta = (AllowPrivateAccess))
+	float DefaultValue = 0.0f;
+
+	UPROPERTY()
+	TArray<FZkzMultisourceFloatSource> Sources;
+
+	UPROPERTY(Transient, VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess))
+	float ResolvedValue = 0.0f;
+
+	/// Saved along with the sources, so that sources pushed after loading or duplicating don't reuse their ids
+	UPROPERTY()
+	int32 LastSourceId = 0;
+
+	UPROPERTY()
+	int64 LastPushOrder = 0;
+};
+
+template <>
+struct TStructOpsTypeTraits<FZkzMultisourceFloat> : public TStructOpsTypeTraitsBase2<FZkzMultisourceFloat>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+		WithPostSerialize = true,
+	};
+};
+
+USTRUCT()
+struct ZAKAZANEUTILITIES_API FZkzMultisourceIntSource : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Id = 0;
+
+	UPROPERTY()
+	int32 Priority = 0;
+
+	/// Breaks priority ties in favour of the most recently pushed source. Unlike ids, never wraps around.
+	UPROPERTY()
+	int64 PushOrder = 0;
+
+	UPROPERTY()
+	int32 Value = 0;
+};
+
+USTRUCT(BlueprintType, Category = "Zakazane", DisplayName = "Multisource Int")
+struct ZAKAZANEUTILITIES_API FZkzMultisourceInt : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnValueChanged, int32 /*NewValue*/);
+
+	FZkzMultisourceInt() = default;
+
+	FZkzMultisourceInt(EZkzMultisourceResolver InResolver, int32 InDefaultValue);
+
+	FZkzMultisourceSourceHandle PushValue(int32 Value, int32 Priority = 0);
+
+	void PopValue(FZkzMultisourceSourceHandle& Handle);
+
+	int32 GetValue() const;
+
+	void SetDefaultValue(int32 InDefaultValue);
+
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams);
+
+	void PostSerialize(const FArchive& Ar);
+
+	/// Called on both server and clients whenever the resolved value changes
+	FOnValueChanged OnValueChanged;
+
+private:
+	void Resolve();
+
+	UPROPERTY(EditAnywhere, meta = (AllowPrivateAccess))
+	EZkzMultisourceResolver Resolver = EZkzMultisourceResolver::Priority;
+
+	UPROPERTY(EditAnywhere, meta = (AllowPrivateAccess))
+	int32 DefaultValue = 0;
+
+	UPROPERTY()
+	TArray<FZkzMultisourceIntSource> Sources;
+
+	UPROPERTY(Transient, VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess))
+	int32 ResolvedValue = 0;
+
+	/// Saved along with the sources, so that sources pushed after loading or duplicating don't reuse their ids
+	UPROPERTY()
+	int32 LastSourceId = 0;
+
+	UPROPERTY()
+	int64 LastPushOrder = 0;
+};
+
+template <>
+struct TStructOpsTypeTraits<FZkzMultisourceInt> : public TStructOpsTypeTraitsBase2<FZkzMultisourceInt>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+		WithPostSerialize = true,
+	};
+};
+
+USTRUCT()
+struct ZAKAZANEUTILITIES_API FZkzMultisourceBoolSource : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Id = 0;
+};
+
+/// Counterpart of Zkz::FIfAnyMultisourceValue: resolves to !DefaultValue if any source is pushed, DefaultValue
+/// otherwise.
+USTRUCT(BlueprintType, Category = "Zakazane", DisplayName = "Multisource Bool")
+struct ZAKAZANEUTILITIES_API FZkzMultisourceBool : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnValueChanged, bool /*bNewValue*/);
+
+	FZkzMultisourceBool() = default;
+
+	explicit FZkzMultisourceBool(bool bInDefaultValue);
+
+	FZkzMultisourceSourceHandle PushValue();
+
+	void PopValue(FZkzMultisourceSourceHandle& Handle);
+
+	bool GetValue() const;
+
+	void SetDefaultValue(bool bInDefaultValue);
+
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams);
+
+	void PostSerialize(const FArchive& Ar);
+
+	/// Called on both server and clients whenever the resolved value changes
+	FOnValueChanged OnValueChanged;
+
+private:
+	void Resolve();
+
+	UPROPERTY(EditAnywhere, meta = (AllowPrivateAccess))
+	bool bDefaultValue = false;
+
+	UPROPERTY()
+	TArray<FZkzMultisourceBoolSource> Sources;
+
+	UPROPERTY(Transient, VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess))
+	bool bResolvedValue = false;
+
+	/// Saved along with the sources, so that sources pushed after loading or duplicating don't reuse their ids
+	UPROPERTY()
+	int32 LastSourceId = 0;
+
+	UPROPERTY()
+	int64 LastPushOrder = 0;
+};
+
+template <>
+struct TStructOpsTypeTraits<FZkzMultisourceBool> : public TStructOpsTypeTraitsBase2<FZkzMultisourceBool>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+		WithPostSerialize = true,
+	};
+};
+
+UCLASS(Category = "Zakazane|MultisourceValue")
+class ZAKAZANEUTILITIES_API UZkzMultisourceValueBlueprintFunctionLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+public:
+	/// Pushes a source onto the value. Priority is only used by the Priority resolver.
+	UFUNCTION(BlueprintCallable)
+	static FZkzMultisourceSourceHandle PushFloat(
+		UPARAM(ref) FZkzMultisourceFloat& MultisourceFloat, float Value, int32 Priority = 0);
+
+	/// Pops the source and resets the handle. Popping an already popped source does nothing.
+	UFUNCTION(BlueprintCallable)
+	static void PopFloat(
+		UPARAM(ref) FZkzMultisourceFloat& MultisourceFloat, UPARAM(ref) FZkzMultisourceSourceHandle& Handle);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure)
+	static float GetFloat(const FZkzMultisourceFloat& MultisourceFloat);
+
+	/// Pushes a source onto the value. Priority is only used by the Priority resolver.
+	UFUNCTION(BlueprintCallable)
+	static FZkzMultisourceSourceHandle PushInt(
+		UPARAM(ref) FZkzMultisourceInt& MultisourceInt, int32 Value, int32 Priority = 0);
+
+	/// Pops the source and resets the handle. Popping an already popped source does nothing.
+	UFUNCTION(BlueprintCallable)
+	static void PopInt(UPARAM(ref) FZkzMultisourceInt& MultisourceInt, UPARAM(ref) FZkzMultisourceSourceHandle& Handle);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure)
+	static int32 GetInt(const FZkzMultisourceInt& MultisourceInt);
+
+	UFUNCTION(BlueprintCallable)
+	static FZkzMultisourceSourceHandle PushBool(UPARAM(ref) FZkzMultisourceBool& MultisourceBool);
+
+	/// Pops the source and resets the handle. Popping an already popped source does nothing.
+	UFUNCTION(BlueprintCallable)
+	static void PopBool(
+		UPARAM(ref) FZkzMultisourceBool& MultisourceBool, UPARAM(ref) FZkzMultisourceSourceHandle& Handle);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure)
+	static bool GetBool(const FZkzMultisourceBool& MultisourceBool);
+};
@@ -15,7 +15,8 @@ public class ZakazaneUtilities : ModuleRules
 				"AssetRegistry",
 				"Core",
 				"CoreUObject",
-				"Engine"
+				"Engine",
+				"NetCore"
 			}
 		);
 
@@ -0,0 +1,47 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#include "ZkzDecodeBinaryLogCommandlet.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ZakazaneGameEditorLog.h"
+#include "Zakazane/BinaryLog.h"
+
+int32 UZkzDecodeBinaryLogCommandlet::Main(const FString& Params)
+{
+	FString InPath;
+	if (!FParse::Value(*Params, TEXT("In="), InPath))
+	{
+		UE_LOG(LogZakazaneGameEditor, Error, TEXT("Missing -In=<Path> of the binary log to decode"));
+		return 1;
+	}
+
+	FString OutPath;
+	if (!FParse::Value(*Params, TEXT("Out="), OutPath))
+	{
+		OutPath = FPaths::ChangeExtension(InPath, TEXT("log"));
+	}
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *InPath))
+	{
+		UE_LOG(LogZakazaneGameEditor, Error, TEXT("Failed to read %s"), *InPath);
+		return 1;
+	}
+
+	FString Text;
+	if (!Zkz::BinaryLog::Decode(Data, Text))
+	{
+		UE_LOG(LogZakazaneGameEditor, Error, TEXT("%s is not a binary log"), *InPath);
+		return 1;
+	}
+
+	if (!FFileHelper::SaveStringToFile(Text, *OutPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogZakazaneGameEditor, Error, TEXT("Failed to write %s"), *OutPath);
+		return 1;
+	}
+
+	UE_LOG(LogZakazaneGameEditor, Display, TEXT("Decoded %s to %s"), *InPath, *OutPath);
+	return 0;
+}
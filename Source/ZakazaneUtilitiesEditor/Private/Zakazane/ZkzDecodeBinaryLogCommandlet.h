@@ -0,0 +1,18 @@
+// Copyright ZAKAZANE Studio. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ZkzDecodeBinaryLogCommandlet.generated.h"
+
+/// Decodes a file recorded by Zkz::BinaryLog to text.
+/// Usage: -run=ZkzDecodeBinaryLog -In=<Path.zkzlog> [-Out=<Path.log>], writing next to the input by default.
+UCLASS()
+class UZkzDecodeBinaryLogCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,198 @@
+#include "Async/Async.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Zakazane/BinaryLog.h"
+#include "Zakazane/Logging.h"
+#include "Zakazane/ReturnIfMacros.h"
+#include "Zakazane/Test/Test.h"
+
+namespace Zkz::Test
+{
+
+DEFINE_LOG_CATEGORY_STATIC(LogZkzBinaryLogTest, Log, All);
+
+/// True if the raw bytes of the string appear anywhere in the data
+bool ContainsRawString(const TConstArrayView<uint8> Data, const FString& String)
+{
+	const int32 NumBytes = String.Len() * sizeof(TCHAR);
+	for (int32 Offset = 0; Offset + NumBytes <= Data.Num(); ++Offset)
+	{
+		if (FMemory::Memcmp(Data.GetData() + Offset, *String, NumBytes) == 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/// Tests restart the recording, which would end the session the developer has running and lose its output
+bool SkipIfAlreadyRecording(FAutomationTestBase& Test)
+{
+	ZKZ_RETURN_IF(!BinaryLog::IsRecording(), false);
+
+	Test.AddWarning(TEXT("Skipped, the binary log is already recording"));
+	return true;
+}
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FBinaryLogTest,
+	"Zakazane.ZakazaneUtilities.BinaryLog",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(RecordedEntriesDecodeToText)
+{
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("BinaryLogTest.zkzlog"));
+	if (SkipIfAlreadyRecording(*this) || !TestTrue("Started", BinaryLog::Start(FilePath)))
+	{
+		return;
+	}
+
+	const FName Category = TEXT("LogBinaryLogTest");
+	BinaryLog::Record(Category, ELogVerbosity::Warning, TEXT("Int %d, unsigned %u, float %.2f"), -3, 7u, 1.5f);
+	BinaryLog::Record(Category, ELogVerbosity::Log, TEXT("String %s, ansi %s, %5.1f%%"), TEXT("wide"), "narrow", 12.5);
+	BinaryLog::Stop();
+
+	BinaryLog::Record(Category, ELogVerbosity::Log, TEXT("Not recorded"));
+
+	TArray<uint8> Data;
+	if (!TestTrue("File written", FFileHelper::LoadFileToArray(Data, *FilePath)))
+	{
+		return;
+	}
+
+	FString Text;
+	TestTrue("Decoded", BinaryLog::Decode(Data, Text));
+	TestTrue(
+		"Formats ints and floats", Text.Contains(TEXT("LogBinaryLogTest: Warning: Int -3, unsigned 7, float 1.50")));
+	TestTrue("Formats strings", Text.Contains(TEXT("Log: String wide, ansi narrow,  12.5%")));
+	TestFalse("Nothing recorded after stop", Text.Contains(TEXT("Not recorded")));
+
+	// Truncated file decodes up to where it ends
+	FString TruncatedText;
+	TestTrue("Truncated decoded", BinaryLog::Decode(TConstArrayView<uint8>{Data}.LeftChop(4), TruncatedText));
+	TestTrue("Complete entries kept", TruncatedText.Contains(TEXT("Int -3")));
+}
+
+ZKZ_ADD_TEST(FormattedLogsRecordTheirFormat)
+{
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("BinaryLogFormatTest.zkzlog"));
+	if (SkipIfAlreadyRecording(*this) || !TestTrue("Started", BinaryLog::Start(FilePath)))
+	{
+		return;
+	}
+
+	LogToScreenAndConsolef(LogZkzBinaryLogTest, ELogVerbosity::Log, TEXT("Compact message %d"), 42);
+	LogToScreenAndConsolef(LogZkzBinaryLogTest, ELogVerbosity::VeryVerbose, TEXT("Suppressed message %d"), 7);
+	BinaryLog::Stop();
+
+	TArray<uint8> Data;
+	if (!TestTrue("File written", FFileHelper::LoadFileToArray(Data, *FilePath)))
+	{
+		return;
+	}
+
+	TestTrue("Written message recorded with its format", ContainsRawString(Data, TEXT("Compact message %d")));
+	TestFalse("Written message not recorded formatted", ContainsRawString(Data, TEXT("Compact message 42")));
+	TestTrue("Suppressed message recorded", ContainsRawString(Data, TEXT("Suppressed message %d")));
+
+	FString Text;
+	TestTrue("Decoded", BinaryLog::Decode(Data, Text));
+	TestTrue("Written message decoded", Text.Contains(TEXT("LogZkzBinaryLogTest: Log: Compact message 42")));
+	const int32 FirstIdx = Text.Find(TEXT("Compact message 42"));
+	const int32 LastIdx = Text.Find(TEXT("Compact message 42"), ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+	TestEqual("Written message recorded once", FirstIdx, LastIdx);
+	TestTrue("Suppressed message decoded", Text.Contains(TEXT("Suppressed message 7")));
+}
+
+ZKZ_ADD_TEST(EntriesOfExitedThreadsAreKept)
+{
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("BinaryLogThreadTest.zkzlog"));
+	if (SkipIfAlreadyRecording(*this) || !TestTrue("Started", BinaryLog::Start(FilePath)))
+	{
+		return;
+	}
+
+	// Each on its own thread, which exits and retires its buffer right after
+	for (int32 ThreadIdx = 0; ThreadIdx < 4; ++ThreadIdx)
+	{
+		const auto RecordFromThread = [ThreadIdx]
+		{ BinaryLog::Record(TEXT("LogBinaryLogTest"), ELogVerbosity::Log, TEXT("From exiting thread %d"), ThreadIdx); };
+		Async(EAsyncExecution::Thread, RecordFromThread).Wait();
+	}
+
+	BinaryLog::Flush();
+	BinaryLog::Record(TEXT("LogBinaryLogTest"), ELogVerbosity::Log, TEXT("After the threads exited"));
+	BinaryLog::Stop();
+
+	TArray<uint8> Data;
+	if (!TestTrue("File written", FFileHelper::LoadFileToArray(Data, *FilePath)))
+	{
+		return;
+	}
+
+	FString Text;
+	TestTrue("Decoded", BinaryLog::Decode(Data, Text));
+	for (int32 ThreadIdx = 0; ThreadIdx < 4; ++ThreadIdx)
+	{
+		TestTrue(
+			FString::Printf(TEXT("Thread %d entry kept"), ThreadIdx),
+			Text.Contains(FString::Printf(TEXT("From exiting thread %d"), ThreadIdx)));
+	}
+
+	TestTrue("Recording goes on", Text.Contains(TEXT("After the threads exited")));
+}
+
+ZKZ_ADD_TEST(RejectsOtherData)
+{
+	const TArray<uint8> Data{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+	FString Text;
+	TestFalse("Not a binary log", BinaryLog::Decode(Data, Text));
+}
+
+ZKZ_ADD_TEST(StopsAtCorruptEntrySize)
+{
+	const FString FilePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("BinaryLogCorruptTest.zkzlog"));
+	if (SkipIfAlreadyRecording(*this) || !TestTrue("Started", BinaryLog::Start(FilePath)))
+	{
+		return;
+	}
+
+	const FName Category = TEXT("LogBinaryLogTest");
+	BinaryLog::Record(Category, ELogVerbosity::Log, TEXT("Intact entry %d"), 1);
+	BinaryLog::Flush();
+	BinaryLog::Record(Category, ELogVerbosity::Log, TEXT("Corrupted entry %d"), 2);
+	BinaryLog::Stop();
+
+	TArray<uint8> Data;
+	if (!TestTrue("File written", FFileHelper::LoadFileToArray(Data, *FilePath)))
+	{
+		return;
+	}
+
+	// The second entry ends the file, it starts with its size: the header and a single int arg
+	const uint32 EntrySize = BinaryLog::Private::EntryHeaderSize + sizeof(BinaryLog::Private::EArgType) + sizeof(int64);
+	const int32 EntrySizeOffset = Data.Num() - static_cast<int32>(EntrySize);
+	uint32 RecordedSize = 0;
+	FMemory::Memcpy(&RecordedSize, Data.GetData() + EntrySizeOffset, sizeof(RecordedSize));
+	if (!TestEqual("Entry located", RecordedSize, EntrySize))
+	{
+		return;
+	}
+
+	// Sizes which would move the offset out of the data, or overflow it, stop decoding
+	for (const uint32 CorruptSize : {uint32{0}, uint32{MAX_uint32}, uint32{MAX_int32} + 8u, uint32(Data.Num())})
+	{
+		TArray<uint8> CorruptData = Data;
+		FMemory::Memcpy(CorruptData.GetData() + EntrySizeOffset, &CorruptSize, sizeof(CorruptSize));
+
+		FString Text;
+		TestTrue(FString::Printf(TEXT("Decoded with size %u"), CorruptSize), BinaryLog::Decode(CorruptData, Text));
+		TestTrue("Entries before kept", Text.Contains(TEXT("Intact entry 1")));
+		TestFalse("Corrupt entry dropped", Text.Contains(TEXT("Corrupted entry 2")));
+	}
+}
+
+ZKZ_END_AUTOMATION_TEST(FBinaryLogTest);
+
+}  // namespace Zkz::Test
@@ -0,0 +1,92 @@
+#include "Curves/CurveFloat.h"
+#include "Zakazane/CurveLookupTable.h"
+#include "Zakazane/InterpolatedValue.h"
+#include "Zakazane/Test/Test.h"
+
+namespace Zkz::Test
+{
+
+UCurveFloat* MakeEaseCurve()
+{
+	UCurveFloat* const Curve = NewObject<UCurveFloat>();
+	Curve->FloatCurve.AddKey(0.0f, 0.0f);
+	Curve->FloatCurve.AddKey(2.0f, 1.0f);
+	for (auto It = Curve->FloatCurve.GetKeyHandleIterator(); It; ++It)
+	{
+		Curve->FloatCurve.SetKeyInterpMode(*It, RCIM_Cubic);
+	}
+
+	return Curve;
+}
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FCurveLookupTableTest,
+	"Zakazane.ZakazaneUtilities.CurveLookupTable",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(MatchesCurve)
+{
+	const UCurveFloat* const Curve = MakeEaseCurve();
+	const FCurveLookupTable Table{Curve->FloatCurve};
+
+	TestEqual("Time range", Table.GetMaxTime(), 2.0f);
+	for (float Time = -0.5f; Time <= 2.5f; Time += 0.1f)
+	{
+		TestNearlyEqual(
+			FString::Printf(TEXT("At %f"), Time), Table.Evaluate(Time), Curve->GetFloatValue(Time), 0.001f);
+	}
+
+	TestEqual("Normalized", Table.EvaluateNormalized(0.5f), Table.Evaluate(1.0f));
+	TestEqual("Empty curve", FCurveLookupTable{FRichCurve{}}.Evaluate(1.0f), FRichCurve{}.GetDefaultValue());
+}
+
+ZKZ_ADD_TEST(SharedPerCurve)
+{
+	const UCurveFloat* const Curve = MakeEaseCurve();
+	const TSharedRef<const FCurveLookupTable> Table = FCurveLookupTable::GetShared(*Curve);
+
+	TestTrue("Same curve shares the table", Table == FCurveLookupTable::GetShared(*Curve));
+	TestTrue("Other curves don't", Table != FCurveLookupTable::GetShared(*MakeEaseCurve()));
+}
+
+#if WITH_EDITOR
+ZKZ_ADD_TEST(RebakedAfterCurveEdit)
+{
+	UCurveFloat* const Curve = MakeEaseCurve();
+	const TSharedRef<const FCurveLookupTable> Table = FCurveLookupTable::GetShared(*Curve);
+	TestTrue("Baked from the curve", Table->IsBakedFrom(Curve->FloatCurve));
+
+	Curve->FloatCurve.UpdateOrAddKey(2.0f, 3.0f);
+	TestFalse("Stale after edit", Table->IsBakedFrom(Curve->FloatCurve));
+
+	const TSharedRef<const FCurveLookupTable> RebakedTable = FCurveLookupTable::GetShared(*Curve);
+	TestTrue("Rebaked", Table != RebakedTable);
+	TestEqual("Stale table keeps the old shape", Table->Evaluate(2.0f), 1.0f);
+	TestEqual("Rebaked table has the new shape", RebakedTable->Evaluate(2.0f), 3.0f);
+	TestTrue("Rebaked table shared", RebakedTable == FCurveLookupTable::GetShared(*Curve));
+}
+#endif
+
+ZKZ_ADD_TEST(CurveInterpolatedValue)
+{
+	FZkzCurveInterpolatedFloatValue Value{MakeEaseCurve(), 1.0f};
+
+	int32 NumArrivals = 0;
+	Value.OnArrived.AddLambda([&NumArrivals] { ++NumArrivals; });
+
+	Value.SetTarget(10.0f);
+	Value.Update(0.25f);
+	TestTrue("Eases in", Value.GetCurrent() > 0.0f && Value.GetCurrent() < 2.5f);
+
+	Value.Update(0.25f);
+	TestNearlyEqual("Halfway", Value.GetCurrent(), 5.0f, 0.1f);
+
+	Value.Update(0.5f);
+	TestEqual("Arrives after the duration", Value.GetCurrent(), 10.0f);
+	TestTrue("Settled", Value.IsSettled());
+	TestEqual("Arrived once", NumArrivals, 1);
+}
+
+ZKZ_END_AUTOMATION_TEST(FCurveLookupTableTest);
+
+}  // namespace Zkz::Test
@@ -1,6 +1,8 @@
 #include "Algo/Transform.h"
+#include "HAL/IConsoleManager.h"
 #include "Zakazane/Functional.h"
 #include "Zakazane/Future.h"
+#include "Zakazane/PooledPromise.h"
 #include "Zakazane/Test/Test.h"
 
 namespace Zkz::Test
@@ -106,6 +108,60 @@ ZKZ_ADD_TEST(ScopedPromiseSetsOnDeleteIfNotExecutedOrMovedFrom)
 	}
 }
 
+ZKZ_ADD_TEST(ScopedPromiseSetsInlineCancelledValue)
+{
+	const TFuture F = []
+	{
+		TScopedPromise<int> P{-1};
+		return P.GetFuture();
+	}();
+
+	TestEqual("CancelledValuePresentInFuture", F.Get(), -1);
+
+	const TFuture MovedF = []
+	{
+		TScopedPromise<int> MovedFrom{-1};
+		TFuture F = MovedFrom.GetFuture();
+
+		{
+			TScopedPromise<int> MovedTo{-2};
+			MovedTo = MoveTemp(MovedFrom);
+		}
+
+		return F;
+	}();
+
+	TestEqual("CancelledValuePresentInFutureMoveAssigned", MovedF.Get(), -1);
+
+	{
+		TScopedPromise<int> Overwritten{-3};
+		const TFuture<int> OverwrittenF = Overwritten.GetFuture();
+
+		Overwritten = TScopedPromise<int>{-4};
+		TestTrue("OverwrittenPromiseResolved", OverwrittenF.IsReady());
+		TestEqual("CancelledValuePresentInOverwrittenFuture", OverwrittenF.Get(), -3);
+
+		Overwritten.SetValue(5);
+	}
+
+	// Converted to the result type, rather than required to match it
+	const TFuture ConvertedF = []
+	{
+		TScopedPromise<int64> P{0};
+		return P.GetFuture();
+	}();
+
+	TestEqual("ConvertedCancelledValuePresentInFuture", ConvertedF.Get(), int64{0});
+
+	const TFuture StringF = []
+	{
+		TScopedPromise<FString> P{TEXT("Cancelled")};
+		return P.GetFuture();
+	}();
+
+	TestEqual("ConstructedCancelledValuePresentInFuture", StringF.Get(), FString{TEXT("Cancelled")});
+}
+
 ZKZ_ADD_TEST(AggregateFuturesAccumulatesResults)
 {
 	TArray<TPromise<int>> Promises;
@@ -172,6 +228,320 @@ ZKZ_ADD_TEST(AggregateFuturesCanUseScopedPromise)
 	TestEqual("AggregateFuturesAccumulatesResults", AggregatedFuture.Get(), 20);
 }
 
+ZKZ_ADD_TEST(InstrumentedFuturesPassValuesThrough)
+{
+	IConsoleVariable* const InstrumentationCVar =
+		IConsoleManager::Get().FindConsoleVariable(TEXT("Zkz.Async.Instrumentation"));
+	const bool bWasEnabled = InstrumentationCVar != nullptr && InstrumentationCVar->GetBool();
+	if (InstrumentationCVar != nullptr)
+	{
+		InstrumentationCVar->Set(true);
+	}
+
+#if ZKZ_WITH_ASYNC_INSTRUMENTATION
+	AsyncInstrumentation::ResetStats();
+#endif
+
+	{
+		TScopedPromise<int> CancelledPromise{-1};
+		CancelledPromise.SetInstrumentationTag("Test.Cancelled");
+		const TFuture<int> CancelledFuture = CancelledPromise.GetFuture();
+		{
+			TScopedPromise<int> Moved = MoveTemp(CancelledPromise);
+		}
+		TestEqual("TaggedPromiseCancelled", CancelledFuture.Get(), -1);
+	}
+
+	TArray<TScopedPromise<int>> Promises;
+	TArray<TFuture<int>> Futures;
+	for (int Idx = 0; Idx < 3; ++Idx)
+	{
+		Promises.Emplace_GetRef(0).SetInstrumentationTag("Test.Input");
+		Futures.Emplace(Promises.Last().GetFuture());
+	}
+
+	const TFuture<int> SumFuture = AggregateFutures(
+		"Test.Sum", MoveTemp(Futures), 0, [](const int Sum, const int Value) { return Sum + Value; });
+
+	for (int Idx = 0; Idx < Promises.Num(); ++Idx)
+	{
+		Promises[Idx].SetValue(Idx + 1);
+	}
+
+	TestEqual("AggregatedResult", SumFuture.Get(), 6);
+
+	{
+		TScopedPromise<int> OverwrittenPromise{-1};
+		OverwrittenPromise.SetInstrumentationTag("Test.Overwritten");
+		const TFuture<int> OverwrittenFuture = OverwrittenPromise.GetFuture();
+		OverwrittenPromise = TScopedPromise<int>{-2};
+		OverwrittenPromise.SetValue(1);
+		TestEqual("OverwrittenPromiseCancelled", OverwrittenFuture.Get(), -1);
+	}
+
+#if ZKZ_WITH_ASYNC_INSTRUMENTATION
+	if (InstrumentationCVar != nullptr)
+	{
+		const TMap<FName, AsyncInstrumentation::FTagStats> Stats = AsyncInstrumentation::GetStats();
+
+		const AsyncInstrumentation::FTagStats* CancelledStats = Stats.Find("Test.Cancelled");
+		if (TestNotNull("CancelledStats", CancelledStats))
+		{
+			TestEqual("CancelledCount", CancelledStats->CancellationLatency.Count, uint64{1});
+			TestEqual("CancelledFulfilmentCount", CancelledStats->FulfilmentLatency.Count, uint64{0});
+			TestEqual("CancelledPending", CancelledStats->NumPending, int64{0});
+		}
+
+		const AsyncInstrumentation::FTagStats* InputStats = Stats.Find("Test.Input");
+		if (TestNotNull("InputStats", InputStats))
+		{
+			TestEqual("InputFulfilmentCount", InputStats->FulfilmentLatency.Count, uint64{3});
+			TestEqual("InputCancelledCount", InputStats->CancellationLatency.Count, uint64{0});
+			TestEqual("InputPending", InputStats->NumPending, int64{0});
+		}
+
+		const AsyncInstrumentation::FTagStats* SumStats = Stats.Find("Test.Sum");
+		if (TestNotNull("SumStats", SumStats))
+		{
+			TestEqual("SumFulfilmentCount", SumStats->FulfilmentLatency.Count, uint64{1});
+			TestEqual("SumContinuationCount", SumStats->ContinuationTime.Count, uint64{3});
+			TestEqual("SumPending", SumStats->NumPending, int64{0});
+		}
+
+		const AsyncInstrumentation::FTagStats* OverwrittenStats = Stats.Find("Test.Overwritten");
+		if (TestNotNull("OverwrittenStats", OverwrittenStats))
+		{
+			TestEqual("OverwrittenCancelledCount", OverwrittenStats->CancellationLatency.Count, uint64{1});
+			TestEqual("OverwrittenPending", OverwrittenStats->NumPending, int64{0});
+		}
+	}
+#endif
+
+	if (InstrumentationCVar != nullptr)
+	{
+		InstrumentationCVar->Set(bWasEnabled);
+	}
+}
+
+ZKZ_ADD_TEST(WithTimeoutPassesValueFulfilledInTime)
+{
+	{
+		TFuture<int> F = WithTimeout(MakeFulfilledPromise<int>(1).GetFuture(), 10.0, TLiteralFunction<-1>{});
+		TestEqual("ReadyFuturePassedThrough", F.Get(), 1);
+	}
+
+	{
+		TPromise<int> P;
+		TFuture<int> F = WithTimeout(P.GetFuture(), 10.0, TLiteralFunction<-1>{});
+		TestFalse("NotReadyBeforeFulfilled", F.IsReady());
+
+		P.SetValue(2);
+		TestEqual("ValueFulfilledInTimePassed", F.Get(), 2);
+	}
+
+	{
+		TArray<TPromise<int>> Promises;
+		Promises.SetNum(3);
+
+		TArray<TFuture<int>> Futures;
+		for (TPromise<int>& Promise : Promises)
+		{
+			Futures.Emplace(Promise.GetFuture());
+		}
+
+		const TFuture<int> AggregatedFuture =
+			AggregateFuturesWithTimeout(MoveTemp(Futures), 10.0, TLiteralFunction<-1>{}, 0, FSum{});
+
+		for (int Idx = 0; Idx < Promises.Num(); ++Idx)
+		{
+			Promises[Idx].SetValue(Idx + 1);
+		}
+
+		TestEqual("AggregatedValuesFulfilledInTime", AggregatedFuture.Get(), 6);
+	}
+}
+
+ZKZ_ADD_TEST(WithTimeoutFallsBackAfterTimeout)
+{
+	FTimerWheel TimerWheel{1.0};
+	int32 NumFallbackCalls = 0;
+	const auto Fallback = [&NumFallbackCalls]
+	{
+		++NumFallbackCalls;
+		return -1;
+	};
+
+	{
+		TPromise<int> P;
+		TFuture<int> F = WithTimeout(P.GetFuture(), 2.0, Fallback, &TimerWheel);
+
+		TimerWheel.Advance(1.0);
+		TestFalse("NotReadyBeforeTimeout", F.IsReady());
+
+		TimerWheel.Advance(1.0);
+		TestTrue("ReadyAfterTimeout", F.IsReady());
+		TestEqual("FallbackValue", F.Get(), -1);
+
+		P.SetValue(2);
+		TestEqual("LateValueIgnored", F.Get(), -1);
+	}
+
+	{
+		TPromise<int> P;
+		TFuture<int> F = WithDeadline(P.GetFuture(), FPlatformTime::Seconds() + 2.0, Fallback, &TimerWheel);
+
+		P.SetValue(3);
+		TimerWheel.Advance(3.0);
+		TestEqual("ValueFulfilledInTimePassed", F.Get(), 3);
+		TestEqual("TimeoutCancelledByValue", NumFallbackCalls, 1);
+		TestEqual("TimerExpired", TimerWheel.GetNumPending(), 0);
+	}
+
+	{
+		TArray<TPromise<int>> Promises;
+		Promises.SetNum(3);
+
+		TArray<TFuture<int>> Futures;
+		for (TPromise<int>& Promise : Promises)
+		{
+			Futures.Emplace(Promise.GetFuture());
+		}
+
+		const TFuture<int> AggregatedFuture =
+			AggregateFuturesWithTimeout(MoveTemp(Futures), 1.0, Fallback, 0, FSum{}, &TimerWheel);
+		TestEqual("SingleTimerForAllFutures", TimerWheel.GetNumPending(), 1);
+
+		Promises[0].SetValue(5);
+		TimerWheel.Advance(1.0);
+		Promises[1].SetValue(7);
+
+		TestEqual("MissingValuesFallBack", AggregatedFuture.Get(), 5 - 1 - 1);
+		TestEqual("FallbackCalledPerMissingFuture", NumFallbackCalls, 3);
+
+		Promises[2].SetValue(11);
+	}
+}
+
+ZKZ_ADD_TEST(AsyncTransformLimitsJobsInFlight)
+{
+	TArray<TPromise<int>> Promises;
+	Promises.Reserve(10);  // Jobs are launched from within SetValue below, so the array must not reallocate
+
+	const TFuture<TArray<int>> TransformedFuture = AsyncTransform(
+		TArray<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9},
+		3,
+		[&Promises](const int Input)
+		{
+			// Promise index matches the input, as inputs are launched in order
+			check(Promises.Num() == Input);
+			return Promises.Emplace_GetRef().GetFuture();
+		});
+
+	TestEqual("StartsMaxInFlightJobs", Promises.Num(), 3);
+
+	Promises[1].SetValue(10);
+	TestEqual("StartsNextJobWhenOneCompletes", Promises.Num(), 4);
+
+	for (const int Idx : {0, 2, 3})
+	{
+		Promises[Idx].SetValue(Idx * 10);
+	}
+
+	TestEqual("KeepsMaxInFlightJobs", Promises.Num(), 7);
+	TestFalse("NotReadyBeforeAllJobsComplete", TransformedFuture.IsReady());
+
+	for (int Idx = 4; Idx < 10; ++Idx)
+	{
+		Promises[Idx].SetValue(Idx * 10);
+	}
+
+	TestTrue("ReadyWhenAllJobsComplete", TransformedFuture.IsReady());
+	TestEqual("ResultsGivenInInputOrder", TransformedFuture.Get(), {0, 10, 20, 30, 40, 50, 60, 70, 80, 90});
+}
+
+ZKZ_ADD_TEST(AsyncTransformHandlesSynchronousJobs)
+{
+	const TFuture<TArray<int>> TransformedFuture = AsyncTransform(
+		TArray<int>{1, 2, 3},
+		1,
+		[](const int Input) { return MakeFulfilledPromise<int>(Input * Input).GetFuture(); });
+
+	TestTrue("ReadyImmediately", TransformedFuture.IsReady());
+	TestEqual("ResultsGivenInInputOrder", TransformedFuture.Get(), {1, 4, 9});
+
+	const TFuture<TArray<int>> EmptyFuture =
+		AsyncTransform(TArray<int>{}, 2, [](const int Input) { return MakeFulfilledPromise<int>(Input).GetFuture(); });
+	TestTrue("EmptyInputsReadyImmediately", EmptyFuture.IsReady());
+	TestTrue("EmptyInputsGiveEmptyResult", EmptyFuture.Get().IsEmpty());
+}
+
+ZKZ_ADD_TEST(PooledPromiseSetsValueOrCancelledValue)
+{
+	{
+		TPooledPromise<int> P{-1};
+		TPooledFuture<int> F = P.GetFuture();
+		TestFalse("NotReadyBeforeSet", F.IsReady());
+
+		P.SetValue(42);
+		TestTrue("ReadyAfterSet", F.IsReady());
+		TestEqual("SetValuePresentInFuture", F.Get(), 42);
+	}
+
+	{
+		TPooledFuture<bool> F = []
+		{
+			TPooledPromise<bool> P{false};
+			return P.GetFuture();
+		}();
+
+		TestTrue("ReadyAfterPromiseDestroyed", F.IsReady());
+		TestEqual("CancelledValuePresentInFuture", F.Get(), false);
+	}
+
+	{
+		int ContinuationValue = 0;
+
+		TPooledPromise<int> P{-1};
+		P.GetFuture().Next([&ContinuationValue](const int Value) { ContinuationValue = Value; });
+		TestEqual("ContinuationNotCalledBeforeSet", ContinuationValue, 0);
+
+		P.SetValue(7);
+		TestEqual("ContinuationCalledOnSet", ContinuationValue, 7);
+
+		TPooledPromise<int> ReadyP{-1};
+		TPooledFuture<int> ReadyF = ReadyP.GetFuture();
+		ReadyP.SetValue(8);
+		ReadyF.Next([&ContinuationValue](const int Value) { ContinuationValue = Value; });
+		TestEqual("ContinuationCalledImmediatelyIfReady", ContinuationValue, 8);
+		TestFalse("NextInvalidatesFuture", ReadyF.IsValid());
+	}
+}
+
+ZKZ_ADD_TEST(PooledPromiseRecyclesSharedState)
+{
+	// Warm up the pool
+	{
+		TPooledPromise<int32> P{0};
+		TPooledFuture<int32> F = P.GetFuture();
+	}
+
+	const int32 NumAllocatedBefore = TPooledPromise<int32>::GetNumAllocatedStates();
+
+	constexpr int32 NumIterations = 10000;
+	int64 Sum = 0;
+	for (int32 Idx = 0; Idx < NumIterations; ++Idx)
+	{
+		TPooledPromise<int32> P{0};
+		TPooledFuture<int32> F = P.GetFuture();
+		P.SetValue(Idx);
+		Sum += F.Get();
+	}
+
+	TestEqual("AllValuesReceived", Sum, static_cast<int64>(NumIterations) * (NumIterations - 1) / 2);
+	TestEqual(
+		"NoStatesAllocatedAfterWarmUp", TPooledPromise<int32>::GetNumAllocatedStates(), NumAllocatedBefore);
+}
+
 ZKZ_END_AUTOMATION_TEST(FFutureTest);
 
 }  // namespace Zkz::Test
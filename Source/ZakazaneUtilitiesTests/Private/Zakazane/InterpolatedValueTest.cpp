@@ -0,0 +1,64 @@
+#include "Zakazane/InterpolatedValue.h"
+#include "Zakazane/Test/Test.h"
+
+namespace Zkz::Test
+{
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FInterpolatedValueTest,
+	"Zakazane.ZakazaneUtilities.InterpolatedValue",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(SettlesAtTarget)
+{
+	FZkzInterpolatedFloatValue Value{0.0f, true, 5.0f};
+	TestTrue("Settled initially", Value.IsSettled());
+
+	int32 NumArrivals = 0;
+	Value.OnArrived.AddLambda([&NumArrivals] { ++NumArrivals; });
+
+	Value.SetTarget(10.0f);
+	TestFalse("Woken by a new target", Value.IsSettled());
+
+	for (int32 Frame = 0; Frame < 1000 && !Value.IsSettled(); ++Frame)
+	{
+		Value.Update(0.1f);
+	}
+
+	TestTrue("Settled", Value.IsSettled());
+	TestEqual("At target", Value.GetCurrent(), 10.0f);
+	TestEqual("Arrived once", NumArrivals, 1);
+
+	Value.Update(0.1f);
+	TestEqual("Settled update does nothing", NumArrivals, 1);
+}
+
+ZKZ_ADD_TEST(CurrentValueAsTargetSettlesOnUpdate)
+{
+	FZkzInterpolatedFloatValue Value{5.0f, true, 5.0f};
+
+	int32 NumArrivals = 0;
+	Value.OnArrived.AddLambda([&NumArrivals] { ++NumArrivals; });
+
+	Value.SetTarget(5.0f);
+	TestFalse("Woken by any target", Value.IsSettled());
+
+	Value.Update(0.1f);
+	TestTrue("Settled after update", Value.IsSettled());
+	TestEqual("Arrived", NumArrivals, 1);
+}
+
+ZKZ_ADD_TEST(DisabledInterpolationJumpsToTarget)
+{
+	FZkzInterpolatedVectorValue Value{false, 1.0f};
+
+	Value.SetTarget(FVector{100.0, 0.0, 0.0});
+	Value.Update(0.01f);
+
+	TestEqual("At target after a single update", Value.GetCurrent(), FVector{100.0, 0.0, 0.0});
+	TestTrue("Settled", Value.IsSettled());
+}
+
+ZKZ_END_AUTOMATION_TEST(FInterpolatedValueTest)
+
+}  // namespace Zkz::Test
@@ -0,0 +1,164 @@
+#include "Zakazane/InterpolatedValue.h"
+#include "Zakazane/Interpolation.h"
+#include "Zakazane/Test/Test.h"
+#include "Zakazane/ZkzInterpolationSubsystem.h"
+
+namespace Zkz::Test
+{
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FInterpolationSubsystemTest,
+	"Zakazane.ZakazaneUtilities.InterpolationSubsystem",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(BatchUpdateMatchesExponentialPolicy)
+{
+	UZkzInterpolationSubsystem* const Subsystem = NewObject<UZkzInterpolationSubsystem>();
+
+	// Not a multiple of the SIMD width, so that the scalar tail is covered as well
+	constexpr int32 NumFloats = 7;
+	TArray<UZkzInterpolationSubsystem::FHandle> FloatHandles;
+	TArray<float> ExpectedFloats;
+	for (int32 Idx = 0; Idx < NumFloats; ++Idx)
+	{
+		// Includes a non-positive speed, which snaps to target
+		const float InterpSpeed = Idx - 1.0f;
+		FloatHandles.Emplace(Subsystem->AddFloat(0.0f, InterpSpeed));
+		Subsystem->SetFloatTarget(FloatHandles.Last(), 10.0f * Idx);
+
+		float Expected = 0.0f;
+		Interpolation::TExponentialPolicy<float>{InterpSpeed}.Advance(Expected, 10.0f * Idx, 0.1f);
+		ExpectedFloats.Emplace(Expected);
+	}
+
+	const auto VectorHandle = Subsystem->AddVector(FVector::ZeroVector, 2.0f);
+	Subsystem->SetVectorTarget(VectorHandle, FVector{100.0, 0.0, 0.0});
+
+	const FQuat TargetQuat{FRotator{0.0, 90.0, 0.0}};
+	const auto QuatHandle = Subsystem->AddQuat(FQuat::Identity, 2.0f);
+	Subsystem->SetQuatTarget(QuatHandle, TargetQuat);
+
+	Subsystem->UpdateAll(0.1f);
+
+	for (int32 Idx = 0; Idx < NumFloats; ++Idx)
+	{
+		TestEqual(FString::Printf(TEXT("Float %d"), Idx), Subsystem->GetFloat(FloatHandles[Idx]), ExpectedFloats[Idx]);
+	}
+
+	FVector ExpectedVector = FVector::ZeroVector;
+	Interpolation::TExponentialPolicy<FVector>{2.0f}.Advance(ExpectedVector, FVector{100.0, 0.0, 0.0}, 0.1f);
+	TestEqual("Vector", Subsystem->GetVector(VectorHandle), ExpectedVector);
+
+	FQuat ExpectedQuat = FQuat::Identity;
+	Interpolation::TExponentialPolicy<FQuat>{2.0f}.Advance(ExpectedQuat, TargetQuat, 0.1f);
+	TestTrue("Quat", Subsystem->GetQuat(QuatHandle).Equals(ExpectedQuat));
+
+	// Removing swaps the last value into the gap, the remaining handles must stay valid
+	Subsystem->RemoveFloat(FloatHandles[1]);
+	TestEqual("Handle valid after swap removal", Subsystem->GetFloat(FloatHandles.Last()), ExpectedFloats.Last());
+}
+
+ZKZ_ADD_TEST(UpdateIsFrameRateIndependent)
+{
+	UZkzInterpolationSubsystem* const Subsystem = NewObject<UZkzInterpolationSubsystem>();
+
+	// Five floats, so that both the SIMD loop and the scalar tail are covered
+	TArray<UZkzInterpolationSubsystem::FHandle> Handles;
+	for (int32 Idx = 0; Idx < 5; ++Idx)
+	{
+		Handles.Emplace(Subsystem->AddFloat(0.0f, 2.0f));
+		Subsystem->SetFloatTarget(Handles.Last(), 10.0f);
+	}
+
+	for (int32 Step = 0; Step < 4; ++Step)
+	{
+		Subsystem->UpdateAll(0.025f);
+	}
+
+	float Expected = 0.0f;
+	Interpolation::TExponentialPolicy<float>{2.0f}.Advance(Expected, 10.0f, 0.1f);
+
+	for (int32 Idx = 0; Idx < Handles.Num(); ++Idx)
+	{
+		TestEqual(FString::Printf(TEXT("Float %d in smaller steps"), Idx), Subsystem->GetFloat(Handles[Idx]), Expected);
+	}
+}
+
+ZKZ_ADD_TEST(SettledValuesAreSkipped)
+{
+	UZkzInterpolationSubsystem* const Subsystem = NewObject<UZkzInterpolationSubsystem>();
+
+	const auto Moving = Subsystem->AddFloat(0.0f, 5.0f);
+	const auto Snapping = Subsystem->AddFloat(0.0f, 0.0f);
+	const auto Idle = Subsystem->AddFloat(3.0f, 5.0f);
+	TestEqual("New values are settled", Subsystem->GetNumInMotion(), 0);
+
+	TArray<UZkzInterpolationSubsystem::FHandle> Arrived;
+	Subsystem->OnFloatArrived.AddLambda([&Arrived](const UZkzInterpolationSubsystem::FHandle Handle)
+										{ Arrived.Emplace(Handle); });
+
+	Subsystem->SetFloatTarget(Moving, 10.0f);
+	Subsystem->SetFloatTarget(Snapping, 10.0f);
+	TestEqual("Setting a target wakes the value", Subsystem->GetNumInMotion(), 2);
+	TestTrue("Untouched value stays settled", Subsystem->IsFloatSettled(Idle));
+
+	Subsystem->UpdateAll(0.1f);
+	TestTrue("Snapped value arrived", Arrived == TArray<UZkzInterpolationSubsystem::FHandle>{Snapping});
+	TestTrue("Snapped value settled", Subsystem->IsFloatSettled(Snapping));
+	TestFalse("Moving value in motion", Subsystem->IsFloatSettled(Moving));
+	TestEqual("Values keep their handles across partitions", Subsystem->GetFloat(Snapping), 10.0f);
+
+	for (int32 Frame = 0; Frame < 1000 && !Subsystem->IsFloatSettled(Moving); ++Frame)
+	{
+		Subsystem->UpdateAll(0.1f);
+	}
+
+	TestTrue("Moving value arrived", Arrived == TArray<UZkzInterpolationSubsystem::FHandle>{Snapping, Moving});
+	TestEqual("Nothing in motion", Subsystem->GetNumInMotion(), 0);
+	TestEqual("Moving value at target", Subsystem->GetFloat(Moving), 10.0f);
+
+	Subsystem->SetFloatTarget(Moving, 0.0f);
+	Subsystem->RemoveFloat(Moving);
+	TestEqual("Removing a value in motion", Subsystem->GetNumInMotion(), 0);
+	TestEqual("Remaining values intact", Subsystem->GetFloat(Idle), 3.0f);
+}
+
+ZKZ_ADD_TEST(CurrentValueAsTargetSettlesOnUpdate)
+{
+	UZkzInterpolationSubsystem* const Subsystem = NewObject<UZkzInterpolationSubsystem>();
+
+	const auto Float = Subsystem->AddFloat(3.0f, 5.0f);
+	const auto Vector = Subsystem->AddVector(FVector::OneVector, 5.0f);
+
+	int32 NumFloatArrivals = 0;
+	Subsystem->OnFloatArrived.AddLambda([&NumFloatArrivals](UZkzInterpolationSubsystem::FHandle)
+										{ ++NumFloatArrivals; });
+
+	int32 NumVectorArrivals = 0;
+	Subsystem->OnVectorArrived.AddLambda([&NumVectorArrivals](UZkzInterpolationSubsystem::FHandle)
+										 { ++NumVectorArrivals; });
+
+	// Same as the structs, @see FZkzInterpolatedFloatValue::IsSettled
+	Subsystem->SetFloatTarget(Float, 3.0f);
+	Subsystem->SetVectorTarget(Vector, FVector::OneVector);
+	TestFalse("Float woken", Subsystem->IsFloatSettled(Float));
+	TestFalse("Vector woken", Subsystem->IsVectorSettled(Vector));
+
+	Subsystem->UpdateAll(0.1f);
+	TestTrue("Float settled", Subsystem->IsFloatSettled(Float));
+	TestTrue("Vector settled", Subsystem->IsVectorSettled(Vector));
+	TestEqual("Float arrived", NumFloatArrivals, 1);
+	TestEqual("Vector arrived", NumVectorArrivals, 1);
+	TestEqual("Float unchanged", Subsystem->GetFloat(Float), 3.0f);
+
+	FZkzInterpolatedFloatValue Struct{3.0f, true, 5.0f};
+	int32 NumStructArrivals = 0;
+	Struct.OnArrived.AddLambda([&NumStructArrivals] { ++NumStructArrivals; });
+	Struct.SetTarget(3.0f);
+	Struct.Update(0.1f);
+	TestEqual("Arrives the same as the struct", NumStructArrivals, NumFloatArrivals);
+}
+
+ZKZ_END_AUTOMATION_TEST(FInterpolationSubsystemTest)
+
+}  // namespace Zkz::Test
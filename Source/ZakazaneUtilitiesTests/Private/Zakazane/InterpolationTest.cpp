@@ -0,0 +1,169 @@
+#include "Zakazane/Interpolation.h"
+#include "Zakazane/Test/Test.h"
+
+namespace Zkz::Test
+{
+
+template <class ValueType, class PolicyType>
+ValueType Simulate(const ValueType& Start, const ValueType& Target, const PolicyType& Policy, const int32 FrameRate)
+{
+	TInterpolatedValue<ValueType, PolicyType> Value{Start, Policy};
+	Value.SetTarget(Target);
+	for (int32 Frame = 0; Frame < FrameRate / 2; ++Frame)
+	{
+		Value.Update(1.0f / FrameRate);
+	}
+
+	return Value.GetCurrent();
+}
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FInterpolationTest,
+	"Zakazane.ZakazaneUtilities.Interpolation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(FrameRateIndependent)
+{
+	const Interpolation::TExponentialPolicy<float> Exponential{5.0f};
+	TestNearlyEqual(
+		"Exponential",
+		Simulate(0.0f, 100.0f, Exponential, 30),
+		Simulate(0.0f, 100.0f, Exponential, 240),
+		0.01f);
+
+	const Interpolation::TCriticallyDampedSpringPolicy<FVector> Spring{0.5f};
+	TestTrue(
+		"Spring",
+		Simulate(FVector::ZeroVector, FVector{100.0, 0.0, 0.0}, Spring, 30)
+			.Equals(Simulate(FVector::ZeroVector, FVector{100.0, 0.0, 0.0}, Spring, 240), 0.01));
+
+	const Interpolation::TConstantSpeedPolicy<float> ConstantSpeed{100.0f};
+	TestNearlyEqual("Constant speed", Simulate(0.0f, 100.0f, ConstantSpeed, 30), 50.0f, 0.01f);
+}
+
+ZKZ_ADD_TEST(AllTypesArriveAtTarget)
+{
+	auto TestArrives = [this](const TCHAR* What, auto Value, const auto& Target)
+	{
+		Value.SetTarget(Target);
+		for (int32 Frame = 0; Frame < 10000 && !Value.IsSettled(); ++Frame)
+		{
+			Value.Update(1.0f / 60.0f);
+		}
+
+		TestTrue(What, Value.IsSettled());
+	};
+
+	TestArrives(TEXT("Float"), TInterpolatedValue<float>{0.0f}, 10.0f);
+	TestArrives(
+		TEXT("Linear color"),
+		TInterpolatedValue<FLinearColor, Interpolation::TConstantSpeedPolicy<FLinearColor>>{FLinearColor::Black},
+		FLinearColor::Red);
+	TestArrives(
+		TEXT("Quat"),
+		TInterpolatedValue<FQuat, Interpolation::TCriticallyDampedSpringPolicy<FQuat>>{FQuat::Identity},
+		FQuat{FRotator{0.0, 170.0, 0.0}});
+	TestArrives(TEXT("Rotator"), TInterpolatedValue<FRotator>{FRotator::ZeroRotator}, FRotator{0.0, -170.0, 10.0});
+	TestArrives(
+		TEXT("Transform"),
+		TInterpolatedValue<FTransform, Interpolation::TCriticallyDampedSpringPolicy<FTransform>>{FTransform::Identity},
+		FTransform{FRotator{0.0, 90.0, 0.0}, FVector{100.0, 0.0, 0.0}, FVector{2.0}});
+}
+
+ZKZ_ADD_TEST(RotationsTakeShortestArc)
+{
+	TInterpolatedValue<FRotator, Interpolation::TConstantSpeedPolicy<FRotator>> Value{
+		FRotator{0.0, 170.0, 0.0}, Interpolation::TConstantSpeedPolicy<FRotator>{FMath::DegreesToRadians(10.0f)}};
+	Value.SetTarget(FRotator{0.0, -170.0, 0.0});
+	Value.Update(1.0f);
+
+	TestTrue("Crosses 180 degrees", Value.GetCurrent().Equals(FRotator{0.0, 180.0, 0.0}, 0.01));
+}
+
+ZKZ_ADD_TEST(SpringKeepsVelocityOnRetarget)
+{
+	TInterpolatedValue<float, Interpolation::TCriticallyDampedSpringPolicy<float>> Value{0.0f};
+	Value.SetTarget(100.0f);
+	Value.Update(0.05f);
+
+	TestTrue("Moving", Value.GetPolicy().Velocity > 0.0f);
+
+	Value.SetTarget(Value.GetCurrent());
+	Value.Update(0.01f);
+	TestTrue("Overshoots the new target due to velocity", Value.GetCurrent() > Value.GetTarget());
+
+	Value.Reset(0.0f);
+	TestEqual("Reset stops the motion", Value.GetPolicy().Velocity, 0.0f);
+}
+
+ZKZ_ADD_TEST(ClosedFormMatchesUpdate)
+{
+	const Interpolation::TCriticallyDampedSpringPolicy<float> Spring{0.5f};
+	TInterpolatedValue<float, Interpolation::TCriticallyDampedSpringPolicy<float>> Value{0.0f, Spring};
+	Value.SetTarget(100.0f);
+	Value.Update(0.1f);
+
+	// Predicts from the current, already moving state
+	const float Current = Value.GetCurrent();
+	const float Predicted = Value.PredictValue(0.4f);
+	TestEqual("Prediction doesn't change the value", Value.GetCurrent(), Current);
+
+	for (int32 Frame = 0; Frame < 40; ++Frame)
+	{
+		Value.Update(0.01f);
+	}
+
+	TestNearlyEqual("Spring prediction", Value.GetCurrent(), Predicted, 0.01f);
+
+	const Interpolation::TExponentialPolicy<float> Exponential{5.0f};
+	TestNearlyEqual(
+		"Exponential",
+		Exponential.Evaluate(0.0f, 100.0f, 0.5f),
+		Simulate(0.0f, 100.0f, Exponential, 240),
+		0.01f);
+}
+
+ZKZ_ADD_TEST(TimeToTarget)
+{
+	const Interpolation::TExponentialPolicy<float> Exponential{5.0f};
+	const float ExponentialTime = Exponential.GetTimeToTarget(0.0f, 100.0f, 0.01f);
+	TestNearlyEqual("Exponential", ExponentialTime, FMath::Loge(10000.0f) / 5.0f, 0.001f);
+
+	const Interpolation::TConstantSpeedPolicy<FVector> ConstantSpeed{10.0f};
+	TestNearlyEqual(
+		"Constant speed", ConstantSpeed.GetTimeToTarget(FVector::ZeroVector, FVector{100.0, 0.0, 0.0}, 0.0f), 10.0f);
+
+	const Interpolation::TCriticallyDampedSpringPolicy<float> Spring{0.5f};
+	const float SpringTime = Spring.GetTimeToTarget(0.0f, 100.0f, 0.01f);
+	TestTrue("Within tolerance after", 100.0f - Spring.Evaluate(0.0f, 100.0f, SpringTime) <= 0.0101f);
+	TestTrue("Not within tolerance before", 100.0f - Spring.Evaluate(0.0f, 100.0f, SpringTime * 0.95f) > 0.01f);
+
+	TestEqual("Already there", Spring.GetTimeToTarget(100.0f, 100.0f, 0.01f), 0.0f);
+}
+
+ZKZ_ADD_TEST(LazyValueEvaluatesOnRead)
+{
+	const Interpolation::TCriticallyDampedSpringPolicy<float> Spring{0.5f};
+	TLazyInterpolatedValue<float, Interpolation::TCriticallyDampedSpringPolicy<float>> Value{0.0f, Spring, 0.01f};
+	TestTrue("Settled initially", Value.IsSettled(0.0));
+
+	Value.SetTarget(100.0f, 10.0);
+	TestFalse("In motion", Value.IsSettled(10.0));
+	TestNearlyEqual("Matches updating", Value.GetValue(10.5), Simulate(0.0f, 100.0f, Spring, 240), 0.01f);
+
+	// Retargeting continues from the value and velocity at the time
+	const float BeforeRetarget = Value.GetValue(10.2);
+	Value.SetTarget(0.0f, 10.2);
+	TestNearlyEqual("Continuous on retarget", Value.GetValue(10.2), BeforeRetarget, 0.001f);
+	TestTrue("Keeps moving up for a while", Value.GetValue(10.21) > BeforeRetarget);
+
+	const double ArrivalTime = Value.GetArrivalTime();
+	TestTrue("Arrives", Value.IsSettled(ArrivalTime));
+	TestEqual("Reads the target once arrived", Value.GetValue(ArrivalTime + 1.0), 0.0f);
+	TestNearlyEqual(
+		"Time to target", Value.GetTimeToTarget(10.2, 0.01f), static_cast<float>(ArrivalTime - 10.2), 0.001f);
+}
+
+ZKZ_END_AUTOMATION_TEST(FInterpolationTest)
+
+}  // namespace Zkz::Test
@@ -0,0 +1,63 @@
+#include "Zakazane/LogRepeatFilter.h"
+#include "Zakazane/Test/Test.h"
+
+namespace Zkz::Test
+{
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FLogRepeatFilterTest,
+	"Zakazane.ZakazaneUtilities.LogRepeatFilter",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(SuppressesRepeatsWithinWindow)
+{
+	FLogRepeatFilter Filter;
+	TArray<int32> Summaries;
+	auto MakeEmitSummary = [&Summaries]
+	{ return FLogRepeatFilter::FEmitSummary{[&Summaries](const int32 NumRepeats) { Summaries.Emplace(NumRepeats); }}; };
+
+	TestTrue("First is emitted", Filter.Filter(1, 0.0, 1.0, MakeEmitSummary));
+	TestFalse("Repeat is suppressed", Filter.Filter(1, 0.1, 1.0, MakeEmitSummary));
+	TestFalse("Repeat is suppressed", Filter.Filter(1, 0.2, 1.0, MakeEmitSummary));
+	TestTrue("Other message is emitted", Filter.Filter(2, 0.3, 1.0, MakeEmitSummary));
+
+	Filter.Tick(0.5);
+	TestTrue("No summary before the window ends", Summaries.IsEmpty());
+
+	Filter.Tick(1.0);
+	TestTrue("Summary of the repeats", Summaries == TArray<int32>{2});
+	TestEqual("Other message still in its window", Filter.Num(), 1);
+
+	Filter.Tick(1.3);
+	TestTrue("No summary without repeats", Summaries == TArray<int32>{2});
+	TestEqual("All windows ended", Filter.Num(), 0);
+
+	TestTrue("Emitted again after the window", Filter.Filter(1, 2.0, 1.0, MakeEmitSummary));
+}
+
+ZKZ_ADD_TEST(SummaryEmittedWhenRepeatedAfterWindowBeforeTick)
+{
+	FLogRepeatFilter Filter;
+	int32 NumSummaries = 0;
+	auto MakeEmitSummary = [&NumSummaries]
+	{ return FLogRepeatFilter::FEmitSummary{[&NumSummaries](int32) { ++NumSummaries; }}; };
+
+	Filter.Filter(1, 0.0, 1.0, MakeEmitSummary);
+	Filter.Filter(1, 0.5, 1.0, MakeEmitSummary);
+	TestTrue("Emitted after the window", Filter.Filter(1, 1.5, 1.0, MakeEmitSummary));
+	TestEqual("Previous window summarized", NumSummaries, 1);
+}
+
+ZKZ_ADD_TEST(NonPositiveWindowDisablesFiltering)
+{
+	FLogRepeatFilter Filter;
+	auto MakeEmitSummary = [] { return FLogRepeatFilter::FEmitSummary{}; };
+
+	TestTrue("Emitted", Filter.Filter(1, 0.0, 0.0, MakeEmitSummary));
+	TestTrue("Emitted", Filter.Filter(1, 0.0, 0.0, MakeEmitSummary));
+	TestEqual("Nothing tracked", Filter.Num(), 0);
+}
+
+ZKZ_END_AUTOMATION_TEST(FLogRepeatFilterTest);
+
+}  // namespace Zkz::Test
@@ -0,0 +1,119 @@
+#include "Async/ParallelFor.h"
+#include "Zakazane/LogStatistics.h"
+#include "Zakazane/Test/Test.h"
+
+namespace Zkz::Test
+{
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FLogStatisticsTest,
+	"Zakazane.ZakazaneUtilities.LogStatistics",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(TemplateReplacesNumbers)
+{
+	TestEqual("Integers", FLogStatistics::MakeTemplate(TEXT("Took 12 ms for 3 items")), TEXT("Took # ms for # items"));
+	TestEqual("Decimals", FLogStatistics::MakeTemplate(TEXT("Value 1.25.")), TEXT("Value #."));
+	TestEqual("Hex", FLogStatistics::MakeTemplate(TEXT("Object at 0x7ffE12")), TEXT("Object at #"));
+	TestEqual(
+		"Truncated",
+		FLogStatistics::MakeTemplate(*FString::ChrN(FLogStatistics::MaxTemplateLen * 2, TEXT('a'))).Len(),
+		FLogStatistics::MaxTemplateLen);
+}
+
+ZKZ_ADD_TEST(CountsByCategoryAndVerbosity)
+{
+	FLogStatistics Statistics;
+	Statistics.Log(TEXT("LogA"), ELogVerbosity::Warning, TEXT("Warning"));
+	Statistics.Log(TEXT("LogB"), ELogVerbosity::Error, TEXT("Error"));
+	Statistics.Log(TEXT("LogB"), ELogVerbosity::Log, TEXT("Log"));
+	Statistics.Log(TEXT("LogC"), ELogVerbosity::Log, TEXT("Log"));
+	Statistics.Log(TEXT("LogC"), ELogVerbosity::Log, TEXT("Log"));
+
+	const TArray<FLogStatistics::FCategoryStats> Stats = Statistics.GetCategoryStats();
+	if (!TestEqual("Categories", Stats.Num(), 3))
+	{
+		return;
+	}
+
+	TestEqual("Errors first", Stats[0].Category, FName{TEXT("LogB")});
+	TestEqual("Then warnings", Stats[1].Category, FName{TEXT("LogA")});
+	TestEqual("Then the most messages", Stats[2].Category, FName{TEXT("LogC")});
+	TestEqual("Messages", Stats[2].NumMessages[ELogVerbosity::Log], int64{2});
+	TestEqual("Characters", Stats[2].NumChars[ELogVerbosity::Log], int64{6});
+
+	Statistics.Reset();
+	TestEqual(
+		"Reset", Statistics.GetCategoryStats()[0].GetNumMessagesWorseThan(ELogVerbosity::VeryVerbose), int64{0});
+}
+
+ZKZ_ADD_TEST(TracksTopTemplates)
+{
+	FLogStatistics Statistics{2};
+	for (int32 Idx = 0; Idx < 10; ++Idx)
+	{
+		Statistics.Logf(ELogVerbosity::Warning, TEXT("Frequent %d"), Idx);
+	}
+
+	for (int32 Idx = 0; Idx < 5; ++Idx)
+	{
+		Statistics.Logf(ELogVerbosity::Warning, TEXT("Less frequent %d"), Idx);
+	}
+
+	for (int32 Idx = 0; Idx < 20; ++Idx)
+	{
+		// Distinct templates, each seen once
+		Statistics.Logf(ELogVerbosity::Warning, TEXT("Unique %c"), TEXT('A') + Idx);
+	}
+
+	const TArray<FLogStatistics::FTemplateStats> Templates = Statistics.GetTopTemplates();
+	if (!TestEqual("Top templates", Templates.Num(), 2))
+	{
+		return;
+	}
+
+	TestEqual("Most frequent", Templates[0].Template, TEXT("Frequent #"));
+	TestEqual("Exact count", Templates[0].Count, int64{10});
+	TestEqual("No error", Templates[0].MaxError, int64{0});
+	TestEqual("Second", Templates[1].Template, TEXT("Less frequent #"));
+}
+
+ZKZ_ADD_TEST(MergesTemplatesOfAllThreads)
+{
+	FLogStatistics Statistics{2};
+
+	constexpr int32 NumWorkers = 4;
+	ParallelFor(
+		NumWorkers,
+		[&Statistics](const int32 WorkerIdx)
+		{
+			for (int32 Idx = 0; Idx < 10; ++Idx)
+			{
+				Statistics.Logf(ELogVerbosity::Warning, TEXT("Frequent %d"), Idx);
+			}
+
+			for (int32 Idx = 0; Idx < 3; ++Idx)
+			{
+				Statistics.Logf(ELogVerbosity::Warning, TEXT("Worker %d only %d"), WorkerIdx, Idx);
+			}
+		});
+
+	const TArray<FLogStatistics::FTemplateStats> Templates = Statistics.GetTopTemplates();
+	if (!TestEqual("Top templates", Templates.Num(), 2))
+	{
+		return;
+	}
+
+	TestEqual("Most frequent", Templates[0].Template, TEXT("Frequent #"));
+	TestEqual("Counted across threads", Templates[0].Count, int64{10 * NumWorkers});
+	TestEqual("No error", Templates[0].MaxError, int64{0});
+	TestEqual("Second", Templates[1].Template, TEXT("Worker # only #"));
+	TestEqual("Second counted across threads", Templates[1].Count, int64{3 * NumWorkers});
+
+	Statistics.Reset();
+	TestEqual("Reset", Statistics.GetTopTemplates().Num(), 0);
+}
+
+ZKZ_END_AUTOMATION_TEST(FLogStatisticsTest);
+
+}  // namespace Zkz::Test
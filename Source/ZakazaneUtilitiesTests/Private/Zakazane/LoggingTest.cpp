@@ -0,0 +1,174 @@
+#include "Async/ParallelFor.h"
+#include "Engine/Engine.h"
+#include "Zakazane/Logging.h"
+#include "Zakazane/Test/Test.h"
+
+#include <atomic>
+
+namespace Zkz::Test
+{
+
+DEFINE_LOG_CATEGORY_STATIC(LogZkzRepeatSourceTest, Log, All);
+
+/// Counts the messages containing the given text, logged on any thread
+class FMessageCounter final : public FOutputDevice
+{
+public:
+	explicit FMessageCounter(const FString& InText) : Text{InText}
+	{
+	}
+
+	virtual void Serialize(const TCHAR* V, const ELogVerbosity::Type Verbosity, const FName& Category) override
+	{
+		if (FCString::Strstr(V, *Text) != nullptr)
+		{
+			NumMessages.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	virtual bool CanBeUsedOnAnyThread() const override
+	{
+		return true;
+	}
+
+	virtual bool CanBeUsedOnMultipleThreads() const override
+	{
+		return true;
+	}
+
+	const FString Text;
+
+	std::atomic<int32> NumMessages{0};
+};
+
+#if WITH_EDITOR
+
+DEFINE_LOG_CATEGORY_STATIC(LogZkzUserErrorTestA, Log, All);
+DEFINE_LOG_CATEGORY_STATIC(LogZkzUserErrorTestB, Log, All);
+
+struct FFlushedUserErrors
+{
+	FName LogCategoryName;
+
+	/// Worker and error index of each flushed message, in order
+	TArray<TPair<int32, int32>> Errors;
+};
+
+/// Parses the worker and error index out of a "UserErrorTest <Worker> <Error>" message
+TPair<int32, int32> ParseTestUserError(const FTokenizedMessage& Message)
+{
+	const FString Text = Message.ToText().ToString();
+	const int32 StartIdx = Text.Find(TEXT("UserErrorTest"));
+
+	TArray<FString> Parts;
+	Text.Mid(FMath::Max(StartIdx, 0)).ParseIntoArrayWS(Parts);
+	return Parts.Num() == 3 ? TPair<int32, int32>{FCString::Atoi(*Parts[1]), FCString::Atoi(*Parts[2])}
+							: TPair<int32, int32>{INDEX_NONE, INDEX_NONE};
+}
+
+#endif
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FLoggingTest,
+	"Zakazane.ZakazaneUtilities.Logging",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+#if WITH_EDITOR
+ZKZ_ADD_TEST(FlushUserErrorsOncePerCategoryInOrder)
+{
+	UZkzLogSubsystem* const LogSubsystem =
+		GEngine != nullptr ? GEngine->GetEngineSubsystem<UZkzLogSubsystem>() : nullptr;
+	if (!TestNotNull("LogSubsystem", LogSubsystem))
+	{
+		return;
+	}
+
+	// Errors queued before the test aren't part of it
+	LogSubsystem->FlushUserErrors();
+
+	TArray<FFlushedUserErrors> Flushes;
+	const FDelegateHandle FlushedHandle = LogSubsystem->OnUserErrorsFlushed.AddLambda(
+		[&Flushes](const FName LogCategoryName, const TConstArrayView<TSharedRef<FTokenizedMessage>> Messages)
+		{
+			FFlushedUserErrors& Flush = Flushes.Emplace_GetRef();
+			Flush.LogCategoryName = LogCategoryName;
+			for (const TSharedRef<FTokenizedMessage>& Message : Messages)
+			{
+				Flush.Errors.Emplace(ParseTestUserError(*Message));
+			}
+		});
+
+	constexpr int32 NumWorkers = 4;
+	constexpr int32 NumErrorsPerWorker = 32;
+	ParallelFor(
+		NumWorkers,
+		[](const int32 WorkerIdx)
+		{
+			for (int32 ErrorIdx = 0; ErrorIdx < NumErrorsPerWorker; ++ErrorIdx)
+			{
+				// Info, so that the console output doesn't fail the test
+				const FLogCategoryBase& LogCategory = ErrorIdx % 2 == 0
+					? static_cast<const FLogCategoryBase&>(LogZkzUserErrorTestA)
+					: static_cast<const FLogCategoryBase&>(LogZkzUserErrorTestB);
+				LogUserError(
+					LogCategory,
+					EMessageSeverity::Info,
+					FString::Printf(TEXT("UserErrorTest %d %d"), WorkerIdx, ErrorIdx));
+			}
+		});
+
+	LogSubsystem->FlushUserErrors();
+	LogSubsystem->OnUserErrorsFlushed.Remove(FlushedHandle);
+
+	if (!TestEqual("One flush per category", Flushes.Num(), 2))
+	{
+		return;
+	}
+
+	TestEqual("Categories flushed in order", Flushes[0].LogCategoryName, LogZkzUserErrorTestA.GetCategoryName());
+	TestEqual("Categories flushed in order", Flushes[1].LogCategoryName, LogZkzUserErrorTestB.GetCategoryName());
+
+	for (const FFlushedUserErrors& Flush : Flushes)
+	{
+		const FString CategoryName = Flush.LogCategoryName.ToString();
+		TestEqual(CategoryName + TEXT(" messages"), Flush.Errors.Num(), NumWorkers * NumErrorsPerWorker / 2);
+
+		// Errors of different threads interleave, but each thread's errors keep their order
+		TArray<int32> LastErrorIdxByWorker;
+		LastErrorIdxByWorker.Init(INDEX_NONE, NumWorkers);
+		for (const TPair<int32, int32>& Error : Flush.Errors)
+		{
+			if (!TestTrue(CategoryName + TEXT(" message parsed"), LastErrorIdxByWorker.IsValidIndex(Error.Key)))
+			{
+				break;
+			}
+
+			TestTrue(CategoryName + TEXT(" messages in order"), Error.Value > LastErrorIdxByWorker[Error.Key]);
+			LastErrorIdxByWorker[Error.Key] = Error.Value;
+		}
+	}
+}
+#endif
+
+ZKZ_ADD_TEST(RepeatsAreFilteredPerPath)
+{
+	// Unique, so that windows left open by earlier runs don't suppress it
+	const FString Message = FString::Printf(TEXT("RepeatSourceTest %s"), *FGuid::NewGuid().ToString());
+
+	FMessageCounter Counter{Message};
+	GLog->AddOutputDevice(&Counter);
+
+	// Display verbosity and Info severity are the same int, they must not be taken for repeats of each other
+	LogToScreenAndConsole(LogZkzRepeatSourceTest, ELogVerbosity::Display, Message);
+	LogUserError(LogZkzRepeatSourceTest, EMessageSeverity::Info, Message);
+	LogToScreenAndConsole(LogZkzRepeatSourceTest, ELogVerbosity::Display, Message);
+
+	GLog->Flush();
+	GLog->RemoveOutputDevice(&Counter);
+
+	TestEqual("Emitted once by each path", Counter.NumMessages.load(), 2);
+}
+
+ZKZ_END_AUTOMATION_TEST(FLoggingTest);
+
+}  // namespace Zkz::Test
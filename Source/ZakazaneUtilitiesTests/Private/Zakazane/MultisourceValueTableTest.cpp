@@ -0,0 +1,115 @@
+#include "Zakazane/MultisourceValueTable.h"
+#include "Zakazane/Test/Test.h"
+
+namespace Zkz::Test
+{
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FMultisourceValueTableTest,
+	"Zakazane.ZakazaneUtilities.MultisourceValueTable",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(PriorityValuesResolvedInBatch)
+{
+	TMultisourceValueTable<float> Table;
+
+	const auto Speed = Table.AddValue(600.f);
+	const auto Fov = Table.AddValue(90.f);
+	TestEqual("Default value", Table.GetValue(Speed), 600.f);
+
+	const auto Wounded = Table.PushValue(Speed, 300.f, 1);
+	const auto Combat = Table.PushValue(Speed, 800.f, 0);
+	const auto Zoom = Table.PushValue(Fov, 45.f, 0);
+	TestEqual("Values resolved lazily", Table.GetValue(Speed), 600.f);
+	TestEqual("Both values dirty", Table.GetNumDirty(), 2);
+
+	TArray<TMultisourceValueTable<float>::FValueHandle> ChangedValues;
+	Table.ResolveDirty(&ChangedValues);
+	TestEqual("Highest priority wins", Table.GetValue(Speed), 300.f);
+	TestEqual("Values resolved independently", Table.GetValue(Fov), 45.f);
+	TestEqual("Changed values", ChangedValues.Num(), 2);
+
+	Table.PopValue(Wounded);
+	Table.PopValue(Zoom);
+	Table.PopValue(Zoom);
+	ChangedValues.Reset();
+	Table.ResolveDirty(&ChangedValues);
+	TestEqual("Lower priority after pop", Table.GetValue(Speed), 800.f);
+	TestEqual("Default after last pop", Table.GetValue(Fov), 90.f);
+
+	Table.RemoveValue(Speed);
+	TestFalse("Removed value invalid", Table.IsValid(Speed));
+	TestEqual("Sources removed with value", Table.GetNumSources(), 0);
+
+	Table.PopValue(Combat);
+	const auto Reused = Table.AddValue(1.f);
+	TestFalse("Stale handle invalid after row reuse", Table.IsValid(Speed));
+	TestTrue("Reused row valid", Table.IsValid(Reused));
+}
+
+ZKZ_ADD_TEST(SumValuesResolvedInBatch)
+{
+	TMultisourceValueTable<int32, MultisourceValueTable::TSumPolicy<int32>> Table;
+
+	TArray<TMultisourceValueTable<int32, MultisourceValueTable::TSumPolicy<int32>>::FValueHandle> Handles;
+	for (int32 Idx = 0; Idx < 100; ++Idx)
+	{
+		Handles.Emplace(Table.AddValue(0));
+		for (int32 SourceIdx = 0; SourceIdx <= Idx % 4; ++SourceIdx)
+		{
+			Table.PushValue(Handles.Last(), Idx);
+		}
+	}
+
+	Table.ResolveDirty();
+	TestEqual("Nothing dirty after resolve", Table.GetNumDirty(), 0);
+
+	for (int32 Idx = 0; Idx < Handles.Num(); ++Idx)
+	{
+		TestEqual(FString::Printf(TEXT("Sum %d"), Idx), Table.GetValue(Handles[Idx]), Idx * (Idx % 4 + 1));
+	}
+}
+
+ZKZ_ADD_TEST(SourcesStayWithTheirValuesAfterRemovals)
+{
+	using FTable = TMultisourceValueTable<int32, MultisourceValueTable::TSumPolicy<int32>>;
+	FTable Table;
+
+	TArray<FTable::FValueHandle> Handles;
+	for (int32 Idx = 0; Idx < 4; ++Idx)
+	{
+		Handles.Emplace(Table.AddValue(0));
+	}
+
+	// Interleave sources of all values, so that removals move sources of other values around
+	TArray<FTable::FSourceHandle> Sources;
+	for (int32 Round = 0; Round < 3; ++Round)
+	{
+		for (int32 Idx = 0; Idx < Handles.Num(); ++Idx)
+		{
+			Sources.Emplace(Table.PushValue(Handles[Idx], (Idx + 1) * 10 + Round));
+		}
+	}
+
+	Table.PopValue(Sources[0]);
+	Table.PopValue(Sources[5]);
+	Table.RemoveValue(Handles[2]);
+	Table.PopValue(Sources[11]);
+	Table.ResolveDirty();
+
+	TestEqual("Sources of removed value removed", Table.GetNumSources(), 6);
+	TestEqual("First value", Table.GetValue(Handles[0]), 11 + 12);
+	TestEqual("Second value", Table.GetValue(Handles[1]), 20 + 22);
+	TestEqual("Fourth value", Table.GetValue(Handles[3]), 40 + 41);
+
+	Table.RemoveValue(Handles[0]);
+	Table.PopValue(Sources[1]);
+	Table.ResolveDirty();
+	TestEqual("Remaining sources", Table.GetNumSources(), 3);
+	TestEqual("Second value after pop", Table.GetValue(Handles[1]), 22);
+	TestEqual("Fourth value unchanged", Table.GetValue(Handles[3]), 40 + 41);
+}
+
+ZKZ_END_AUTOMATION_TEST(FMultisourceValueTableTest);
+
+}  // namespace Zkz::Test
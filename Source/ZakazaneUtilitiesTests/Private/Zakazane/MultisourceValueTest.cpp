@@ -1,5 +1,10 @@
+#include "Async/ParallelFor.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
 #include "Zakazane/MultisourceValue.h"
 #include "Zakazane/Test/Test.h"
+#include "Zakazane/ZkzMultisourceValue.h"
 
 namespace Zkz::Test
 {
@@ -50,6 +55,101 @@ ZKZ_ADD_TEST(MultiplesSourcesYieldsLatestHighestPriorityDefaultValue)
 	TestEqual("2 sources again", Value.GetValue(), 2);
 }
 
+ZKZ_ADD_TEST(PoppingInAnyOrderKeepsHighestPriorityOnTop)
+{
+	TPriorityBasedMultisourceValue<int32> Value{-1};
+
+	// Value of each source is its priority * 100 + push order, so that the expected winner is simply the max value
+	TArray<int32> PushedValues;
+	TArray<MultisourceValue::FSourceHandle> SourceIds;
+	for (int32 Idx = 0; Idx < 20; ++Idx)
+	{
+		const int32 Priority = (Idx * 7) % 5;
+		PushedValues.Emplace(Priority * 100 + Idx);
+		SourceIds.Emplace(Value.PushValue(PushedValues.Last(), Priority));
+	}
+
+	TestEqual("All sources", Value.GetValue(), FMath::Max(PushedValues));
+
+	for (int32 Step = 0; Step < 20; ++Step)
+	{
+		const int32 PopIdx = (Step * 13) % SourceIds.Num();
+		Value.PopValue(SourceIds[PopIdx]);
+		SourceIds.RemoveAt(PopIdx);
+		PushedValues.RemoveAt(PopIdx);
+
+		TestEqual(
+			FString::Printf(TEXT("After pop %d"), Step),
+			Value.GetValue(),
+			PushedValues.IsEmpty() ? -1 : FMath::Max(PushedValues));
+	}
+
+	const auto StaleSourceId = Value.PushValue(1, 0);
+	Value.PopValue(StaleSourceId);
+	const auto ReusedSlotSourceId = Value.PushValue(2, 0);
+	Value.PopValue(StaleSourceId);
+	TestEqual("Popping stale source is a no-op", Value.GetValue(), 2);
+
+	Value.PopValue(ReusedSlotSourceId);
+	Value.PopValue(MultisourceValue::FSourceHandle{});
+	TestEqual("Popping unset source is a no-op", Value.GetValue(), -1);
+}
+
+ZKZ_ADD_TEST(ExpiringSourcesMayBePoppedOrOutlived)
+{
+	FTimerWheel TimerWheel{1.0};
+
+	{
+		const TSharedRef<TPriorityBasedMultisourceValue<float>> Speed =
+			MakeShared<TPriorityBasedMultisourceValue<float>>(600.f);
+
+		const auto Slow = MultisourceValue::PushExpiringValue(Speed, {2.0, &TimerWheel}, 300.f, 1);
+		MultisourceValue::PushExpiringValue(Speed, {5.0, &TimerWheel}, 200.f, 0);
+		TestEqual("Expiring source active", Speed->GetValue(), 300.f);
+		TestEqual("Expiry scheduled", TimerWheel.GetNumPending(), 2);
+
+		Speed->PopValue(Slow);
+		TestEqual("Expiring source popped manually", Speed->GetValue(), 200.f);
+
+		TimerWheel.Advance(2.5);
+		TestEqual("Expiry of popped source is a no-op", Speed->GetValue(), 200.f);
+		TestEqual("Expiry of other source pending", TimerWheel.GetNumPending(), 1);
+	}
+
+	// The expiry timer of the destroyed value stays scheduled, but won't touch it when it fires
+	TestEqual("Expiry outlives value", TimerWheel.GetNumPending(), 1);
+	TimerWheel.Advance(5.0);
+	TestEqual("Expiry of destroyed value fired", TimerWheel.GetNumPending(), 0);
+}
+
+ZKZ_ADD_TEST(ExpiringSourcesArePoppedAfterDeadline)
+{
+	FTimerWheel TimerWheel{1.0};
+
+	const TSharedRef<TPriorityBasedMultisourceValue<float>> Speed =
+		MakeShared<TPriorityBasedMultisourceValue<float>>(600.f);
+
+	TArray<float> Changes;
+	Speed->OnValueChanged.AddLambda([&Changes](const float NewValue) { Changes.Emplace(NewValue); });
+
+	MultisourceValue::PushExpiringValue(Speed, {2.0, &TimerWheel}, 300.f, 1);
+	MultisourceValue::PushExpiringValue(Speed, {4.0, &TimerWheel}, 200.f, 0);
+	TestEqual("Expiring source active", Speed->GetValue(), 300.f);
+
+	TimerWheel.Advance(1.0);
+	TestEqual("Not expired before deadline", Speed->GetValue(), 300.f);
+
+	TimerWheel.Advance(1.5);
+	TestEqual("First source expired", Speed->GetValue(), 200.f);
+
+	TimerWheel.Advance(2.0);
+	TestEqual("All sources expired", Speed->GetValue(), 600.f);
+	TestEqual("Nothing pending", TimerWheel.GetNumPending(), 0);
+
+	const TArray<float> ExpectedChanges{300.f, 200.f, 600.f};
+	TestEqual("Expiry broadcasts changes", Changes, ExpectedChanges);
+}
+
 ZKZ_END_AUTOMATION_TEST(FPriorityBasedMultisourceValueTest);
 
 ZKZ_BEGIN_AUTOMATION_TEST(
@@ -68,29 +168,290 @@ ZKZ_ADD_TEST(NoSourcesYieldDefaultValue)
 
 ZKZ_ADD_TEST(VotersYieldNegation)
 {
-	int Voter1, Voter2;
-
 	FIfAnyMultisourceValue DefaultTrue{true};
-	DefaultTrue.PushValue(&Voter1);
+	const auto TrueVoter1 = DefaultTrue.PushValue();
 	TestEqual("1 voter yields false", DefaultTrue.GetValue(), false);
-	DefaultTrue.PushValue(&Voter2);
+	const auto TrueVoter2 = DefaultTrue.PushValue();
 	TestEqual("2 voters yields false", DefaultTrue.GetValue(), false);
-	DefaultTrue.PopValue(&Voter1);
+	DefaultTrue.PopValue(TrueVoter1);
 	TestEqual("1 voter again yields false", DefaultTrue.GetValue(), false);
-	DefaultTrue.PopValue(&Voter2);
+	DefaultTrue.PopValue(TrueVoter1);
+	TestEqual("Popping the same voter twice is a no-op", DefaultTrue.GetValue(), false);
+	DefaultTrue.PopValue(TrueVoter2);
 	TestEqual("0 voters yields true", DefaultTrue.GetValue(), true);
 
 	FIfAnyMultisourceValue DefaultFalse{false};
-	DefaultFalse.PushValue(&Voter1);
+	const auto FalseVoter1 = DefaultFalse.PushValue();
 	TestEqual("1 voter yields true", DefaultFalse.GetValue(), true);
-	DefaultFalse.PushValue(&Voter2);
+	const auto FalseVoter2 = DefaultFalse.PushValue();
 	TestEqual("2 voters yields true", DefaultFalse.GetValue(), true);
-	DefaultFalse.PopValue(&Voter1);
+	DefaultFalse.PopValue(FalseVoter1);
 	TestEqual("1 voter again yields true", DefaultFalse.GetValue(), true);
-	DefaultFalse.PopValue(&Voter2);
+	DefaultFalse.PopValue(FalseVoter2);
 	TestEqual("0 voters yields false", DefaultFalse.GetValue(), false);
 }
 
+ZKZ_ADD_TEST(AtomicVotersFromMultipleThreads)
+{
+	FAtomicIfAnyMultisourceValue Highlighted{false};
+
+	constexpr int32 NumVoters = 1000;
+	TArray<FAtomicIfAnyMultisourceValue::FSourceHandle> Voters;
+	Voters.SetNum(NumVoters);
+
+	ParallelFor(NumVoters, [&](const int32 Idx) { Voters[Idx] = Highlighted.PushValue(); });
+	TestEqual("All voters pushed", Highlighted.GetNumSources(), NumVoters);
+	TestEqual("Voters yield true", Highlighted.GetValue(), true);
+
+	ParallelFor(NumVoters - 1, [&](const int32 Idx) { Highlighted.PopValue(Voters[Idx]); });
+	TestEqual("1 voter yields true", Highlighted.GetValue(), true);
+
+	Highlighted.PopValue(Voters.Last());
+	Highlighted.PopValue(Voters.Last());
+	TestEqual("Popping through a reset handle is a no-op", Highlighted.GetNumSources(), 0);
+	TestEqual("0 voters yields false", Highlighted.GetValue(), false);
+}
+
+ZKZ_ADD_TEST(AtomicHandlesAreMoveOnly)
+{
+	FAtomicIfAnyMultisourceValue Highlighted{false};
+
+	FAtomicIfAnyMultisourceValue::FSourceHandle Voter = Highlighted.PushValue();
+	FAtomicIfAnyMultisourceValue::FSourceHandle MovedVoter = MoveTemp(Voter);
+	TestFalse("Moved from handle reset", Voter.IsSet());
+
+	Highlighted.PopValue(Voter);
+	TestEqual("Popping through a moved from handle is a no-op", Highlighted.GetNumSources(), 1);
+
+	Highlighted.PopValue(MovedVoter);
+	Highlighted.PopValue(MovedVoter);
+	TestEqual("Popped once", Highlighted.GetNumSources(), 0);
+}
+
 ZKZ_END_AUTOMATION_TEST(FIfAnyMultisourceValueTest)
 
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FSumMultisourceValueTest,
+	"Zakazane.ZakazaneUtilities.MultisourceValue.Sum",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(SourcesAreSummedUp)
+{
+	TSumMultisourceValue<int32> Value;
+	TestEqual("Empty sums to zero", Value.GetValue(), 0);
+
+	const auto Source1 = Value.PushValue(3);
+	const auto Source2 = Value.PushValue(4);
+	TestEqual("2 sources", Value.GetValue(), 7);
+
+	Value.PopValue(Source1);
+	Value.PopValue(Source1);
+	TestEqual("Popping the same source twice subtracts once", Value.GetValue(), 4);
+
+	Value.PopValue(Source2);
+	TestEqual("Emptied sums to zero", Value.GetValue(), 0);
+}
+
+ZKZ_ADD_TEST(OnValueChangedBroadcastOnlyOnChange)
+{
+	TSumMultisourceValue<int32> Value;
+
+	TArray<int32> BroadcastValues;
+	Value.OnValueChanged.AddLambda([&BroadcastValues](const int32 NewValue) { BroadcastValues.Emplace(NewValue); });
+
+	const auto Source1 = Value.PushValue(3);
+	const auto ZeroSource = Value.PushValue(0);
+	const auto Source2 = Value.PushValue(-3);
+	Value.PopValue(ZeroSource);
+	Value.PopValue(Source1);
+	Value.PopValue(Source2);
+
+	TestEqual("Broadcast values", BroadcastValues, {3, 0, -3, 0});
+
+	FIfAnyMultisourceValue IfAny{false};
+	int32 NumIfAnyBroadcasts = 0;
+	IfAny.OnValueChanged.AddLambda([&NumIfAnyBroadcasts](bool) { ++NumIfAnyBroadcasts; });
+
+	const auto Voter1 = IfAny.PushValue();
+	const auto Voter2 = IfAny.PushValue();
+	IfAny.PopValue(Voter1);
+	TestEqual("Second voter doesn't change the value", NumIfAnyBroadcasts, 1);
+
+	IfAny.SetDefaultValue(true);
+	TestEqual("Changing default value changes the value", NumIfAnyBroadcasts, 2);
+
+	IfAny.PopValue(Voter2);
+	TestEqual("Last voter popped", NumIfAnyBroadcasts, 3);
+	TestEqual("Value after last voter popped", IfAny.GetValue(), true);
+}
+
+ZKZ_END_AUTOMATION_TEST(FSumMultisourceValueTest)
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FOrderedMultisourceValueTest,
+	"Zakazane.ZakazaneUtilities.MultisourceValue.Ordered",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(MinAndMaxYieldExtremeSource)
+{
+	TMinMultisourceValue<float> Slow{1.f};
+	TMaxMultisourceValue<float> Haste{1.f};
+	TestEqual("Min defaults", Slow.GetValue(), 1.f);
+	TestEqual("Max defaults", Haste.GetValue(), 1.f);
+
+	TArray<MultisourceValue::FSourceHandle> SlowSources;
+	TArray<MultisourceValue::FSourceHandle> HasteSources;
+	for (const float Value : {0.8f, 0.5f, 0.9f, 0.7f})
+	{
+		SlowSources.Emplace(Slow.PushValue(Value));
+		HasteSources.Emplace(Haste.PushValue(Value + 1.f));
+	}
+
+	TestEqual("Min", Slow.GetValue(), 0.5f);
+	TestEqual("Max", Haste.GetValue(), 1.9f);
+
+	Slow.PopValue(SlowSources[1]);
+	Haste.PopValue(HasteSources[2]);
+	TestEqual("Min after pop", Slow.GetValue(), 0.7f);
+	TestEqual("Max after pop", Haste.GetValue(), 1.8f);
+}
+
+ZKZ_ADD_TEST(ProductHandlesZeros)
+{
+	TProductMultisourceValue<float> Multiplier;
+	TestEqual("Empty product is one", Multiplier.GetValue(), 1.f);
+
+	const auto Half = Multiplier.PushValue(0.5f);
+	const auto Zero = Multiplier.PushValue(0.f);
+	const auto Triple = Multiplier.PushValue(3.f);
+	TestEqual("Zero source zeroes the product", Multiplier.GetValue(), 0.f);
+
+	Multiplier.PopValue(Zero);
+	TestEqual("Product after popping zero", Multiplier.GetValue(), 1.5f);
+
+	Multiplier.PopValue(Half);
+	Multiplier.PopValue(Triple);
+	TestEqual("Emptied product is one", Multiplier.GetValue(), 1.f);
+}
+
+ZKZ_ADD_TEST(ClampedSumStaysInRange)
+{
+	TClampedSumMultisourceValue<int32> Armor;
+	Armor.ModifyResolver([](auto& Resolver) { Resolver.SetClampRange(0, 100); });
+
+	int32 NumBroadcasts = 0;
+	Armor.OnValueChanged.AddLambda([&NumBroadcasts](int32) { ++NumBroadcasts; });
+
+	const auto Bonus = Armor.PushValue(80);
+	const auto SecondBonus = Armor.PushValue(50);
+	TestEqual("Clamped to max", Armor.GetValue(), 100);
+	TestEqual("Unclamped sum", Armor.GetResolver().GetUnclampedValue(), 130);
+
+	const auto Penalty = Armor.PushValue(-20);
+	TestEqual("Still clamped", Armor.GetValue(), 100);
+	TestEqual("Clamped value didn't change", NumBroadcasts, 2);
+
+	Armor.PopValue(Bonus);
+	Armor.PopValue(SecondBonus);
+	TestEqual("Clamped to min", Armor.GetValue(), 0);
+
+	Armor.ModifyResolver([](auto& Resolver) { Resolver.SetClampRange(-50, 100); });
+	TestEqual("Range change applied", Armor.GetValue(), -20);
+	TestEqual("Range change broadcast", NumBroadcasts, 5);
+
+	Armor.PopValue(Penalty);
+}
+
+ZKZ_END_AUTOMATION_TEST(FOrderedMultisourceValueTest)
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FMultisourceValueStructTest,
+	"Zakazane.ZakazaneUtilities.MultisourceValue.Struct",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(ResolversSelectableByEnum)
+{
+	FZkzMultisourceFloat Priority{EZkzMultisourceResolver::Priority, 1.f};
+	FZkzMultisourceFloat Sum{EZkzMultisourceResolver::Sum, 1.f};
+	FZkzMultisourceFloat Min{EZkzMultisourceResolver::Min, 1.f};
+
+	TArray<FZkzMultisourceSourceHandle> Handles;
+	for (FZkzMultisourceFloat* const Value : {&Priority, &Sum, &Min})
+	{
+		Handles.Emplace(Value->PushValue(0.5f, 1));
+		Handles.Emplace(Value->PushValue(2.f, 0));
+	}
+
+	TestEqual("Priority", Priority.GetValue(), 0.5f);
+	TestEqual("Sum", Sum.GetValue(), 2.5f);
+	TestEqual("Min", Min.GetValue(), 0.5f);
+
+	Priority.PopValue(Handles[0]);
+	TestFalse("Pop resets handle", Handles[0].IsSet());
+	TestEqual("Priority after pop", Priority.GetValue(), 2.f);
+
+	Priority.PopValue(Handles[1]);
+	TestEqual("Priority defaults", Priority.GetValue(), 1.f);
+}
+
+ZKZ_ADD_TEST(BoolAndIntNotifyOnChange)
+{
+	FZkzMultisourceBool Highlighted{false};
+	int32 NumBoolBroadcasts = 0;
+	Highlighted.OnValueChanged.AddLambda([&NumBoolBroadcasts](bool) { ++NumBoolBroadcasts; });
+
+	FZkzMultisourceSourceHandle First = Highlighted.PushValue();
+	FZkzMultisourceSourceHandle Second = Highlighted.PushValue();
+	Highlighted.PopValue(First);
+	TestEqual("Still highlighted", Highlighted.GetValue(), true);
+	Highlighted.PopValue(Second);
+	TestEqual("Not highlighted", Highlighted.GetValue(), false);
+	TestEqual("Bool broadcasts", NumBoolBroadcasts, 2);
+
+	FZkzMultisourceInt Stacks{EZkzMultisourceResolver::Max, 0};
+	TArray<int32> IntBroadcasts;
+	Stacks.OnValueChanged.AddLambda([&IntBroadcasts](const int32 NewValue) { IntBroadcasts.Emplace(NewValue); });
+
+	Stacks.PushValue(3);
+	Stacks.PushValue(2);
+	FZkzMultisourceSourceHandle Top = Stacks.PushValue(5);
+	Stacks.PopValue(Top);
+	TestEqual("Int broadcasts", IntBroadcasts, {3, 5, 3});
+}
+
+ZKZ_ADD_TEST(LoadedSourcesKeepTheirIds)
+{
+	FZkzMultisourceFloat Original{EZkzMultisourceResolver::Priority, 0.f};
+	FZkzMultisourceSourceHandle First = Original.PushValue(1.f);
+	Original.PushValue(2.f);
+
+	TArray<uint8> Bytes;
+	{
+		FMemoryWriter Writer{Bytes};
+		FObjectAndNameAsStringProxyArchive Archive{Writer, false};
+		FZkzMultisourceFloat::StaticStruct()->SerializeItem(Archive, &Original, nullptr);
+	}
+
+	FZkzMultisourceFloat Loaded;
+	{
+		FMemoryReader Reader{Bytes};
+		FObjectAndNameAsStringProxyArchive Archive{Reader, false};
+		FZkzMultisourceFloat::StaticStruct()->SerializeItem(Archive, &Loaded, nullptr);
+	}
+
+	TestEqual("Loaded value", Loaded.GetValue(), 2.f);
+
+	FZkzMultisourceSourceHandle Pushed = Loaded.PushValue(3.f);
+	TestNotEqual("New source gets a new id", Pushed.Id, First.Id);
+	TestEqual("New source is the most recent", Loaded.GetValue(), 3.f);
+
+	Loaded.PopValue(First);
+	TestEqual("Popping loaded source keeps new one", Loaded.GetValue(), 3.f);
+
+	Loaded.PopValue(Pushed);
+	TestEqual("Remaining loaded source", Loaded.GetValue(), 2.f);
+}
+
+ZKZ_END_AUTOMATION_TEST(FMultisourceValueStructTest)
+
 }  // namespace Zkz::Test
@@ -0,0 +1,80 @@
+#include "Async/ParallelFor.h"
+#include "Zakazane/OutputDeviceStatsWrapper.h"
+#include "Zakazane/Test/Test.h"
+
+namespace Zkz::Test
+{
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FOutputDeviceStatsWrapperTest,
+	"Zakazane.ZakazaneUtilities.OutputDeviceStatsWrapper",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(CountsByVerbosityAndCategory)
+{
+	FOutputDeviceStatsWrapper Wrapper{nullptr, true};
+	Wrapper.Log(TEXT("LogA"), ELogVerbosity::Warning, TEXT("Warning"));
+	Wrapper.Log(TEXT("LogA"), ELogVerbosity::Error, TEXT("Error"));
+	Wrapper.Log(TEXT("LogB"), ELogVerbosity::Error, TEXT("Error"));
+	Wrapper.Log(TEXT("LogB"), ELogVerbosity::Log, TEXT("Log"));
+
+	TestEqual("Errors", Wrapper.GetNumMessages(ELogVerbosity::Error), 2);
+	TestEqual("Warnings and worse", Wrapper.GetNumMessagesWorseThan(ELogVerbosity::Warning), 3);
+	TestEqual("Errors of LogA", Wrapper.GetNumMessages(TEXT("LogA"), ELogVerbosity::Error), 1);
+	TestEqual("Warnings of LogB", Wrapper.GetNumMessages(TEXT("LogB"), ELogVerbosity::Warning), 0);
+	TestEqual("Unknown category", Wrapper.GetNumMessages(TEXT("LogC"), ELogVerbosity::Error), 0);
+
+	Wrapper.Reset();
+	TestEqual("Reset", Wrapper.GetNumMessagesWorseThan(ELogVerbosity::VeryVerbose), 0);
+	TestEqual("Reset category", Wrapper.GetNumMessages(TEXT("LogA"), ELogVerbosity::Error), 0);
+}
+
+ZKZ_ADD_TEST(CountsFromMultipleThreads)
+{
+	FOutputDeviceStatsWrapper Wrapper{nullptr, true};
+	TestTrue("Can be used on multiple threads", Wrapper.CanBeUsedOnMultipleThreads());
+
+	constexpr int32 NumMessages = 10000;
+	ParallelFor(
+		NumMessages,
+		[&Wrapper](const int32 Idx)
+		{
+			Wrapper.Log(
+				Idx % 2 == 0 ? TEXT("LogA") : TEXT("LogB"),
+				Idx % 4 < 2 ? ELogVerbosity::Warning : ELogVerbosity::Error,
+				TEXT("Message"));
+		});
+
+	TestEqual("Warnings", Wrapper.GetNumMessages(ELogVerbosity::Warning), NumMessages / 2);
+	TestEqual("Errors", Wrapper.GetNumMessages(ELogVerbosity::Error), NumMessages / 2);
+	TestEqual("Errors of LogA", Wrapper.GetNumMessages(TEXT("LogA"), ELogVerbosity::Error), NumMessages / 4);
+}
+
+ZKZ_ADD_TEST(SnapshotAndMerge)
+{
+	FOutputDeviceStatsWrapper Worker{nullptr, true};
+	Worker.Log(TEXT("LogA"), ELogVerbosity::Error, TEXT("Error"));
+	Worker.Log(TEXT("LogA"), ELogVerbosity::Warning, TEXT("Warning"));
+
+	FOutputDeviceStatsWrapper::FSnapshot Snapshot = Worker.GetSnapshot();
+	TestEqual("Snapshot errors", Snapshot.GetNumMessages(ELogVerbosity::Error), 1);
+	TestEqual("Snapshot category", Snapshot.GetNumMessages(TEXT("LogA"), ELogVerbosity::Warning), 1);
+
+	Snapshot += Worker.GetSnapshot();
+	TestEqual("Snapshots added", Snapshot.GetNumMessagesWorseThan(ELogVerbosity::Warning), 4);
+
+	FOutputDeviceStatsWrapper Shared{nullptr, true};
+	Shared.Log(TEXT("LogB"), ELogVerbosity::Error, TEXT("Error"));
+	Shared.Merge(Snapshot);
+	TestEqual("Merged errors", Shared.GetNumMessages(ELogVerbosity::Error), 3);
+	TestEqual("Merged category", Shared.GetNumMessages(TEXT("LogA"), ELogVerbosity::Error), 2);
+
+	FOutputDeviceStatsWrapper WithoutCategories{nullptr};
+	WithoutCategories.Merge(Snapshot);
+	TestEqual("Merged without categories", WithoutCategories.GetNumMessages(ELogVerbosity::Error), 2);
+	TestEqual("Categories not counted", WithoutCategories.GetNumMessages(TEXT("LogA"), ELogVerbosity::Error), 0);
+}
+
+ZKZ_END_AUTOMATION_TEST(FOutputDeviceStatsWrapperTest);
+
+}  // namespace Zkz::Test
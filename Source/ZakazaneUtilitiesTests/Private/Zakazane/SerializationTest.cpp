@@ -0,0 +1,118 @@
+#include "Misc/App.h"
+#include "Zakazane/ReturnIfMacros.h"
+#include "Zakazane/Serialization.h"
+#include "Zakazane/Test/Test.h"
+
+namespace Zkz::Test
+{
+
+/// CSV of FVectors, with every tenth row missing a column
+FString MakeVectorCSV(const int32 NumRows)
+{
+	TStringBuilder<4096> CSV;
+	CSV << TEXT("X,Y,Z\n");
+	for (int32 RowIdx = 0; RowIdx < NumRows; ++RowIdx)
+	{
+		if (RowIdx % 10 == 9)
+		{
+			CSV.Appendf(TEXT("%d,0\n"), RowIdx);
+		}
+		else
+		{
+			CSV.Appendf(TEXT("%d,%d,0\n"), RowIdx, RowIdx * 2);
+		}
+	}
+
+	return FString{CSV.ToView()};
+}
+
+/// Records messages logged by the import
+class FRecordingOutput final : public FOutputDevice
+{
+public:
+	virtual void Serialize(const TCHAR* V, const ELogVerbosity::Type Verbosity, const FName& Category) override
+	{
+		Messages.Emplace(V);
+	}
+
+	TArray<FString> Messages;
+};
+
+/// The import falls back to serial without threading, which would pass the parallel tests without testing anything
+bool SkipIfNotThreaded(FAutomationTestBase& Test)
+{
+	ZKZ_RETURN_IF(FApp::ShouldUseThreadingForPerformance(), false);
+
+	Test.AddWarning(TEXT("Skipped, threading is disabled"));
+	return true;
+}
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FSerializationTest,
+	"Zakazane.ZakazaneUtilities.Serialization",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(ParallelImportMatchesSerial)
+{
+	ZKZ_RETURN_IF(SkipIfNotThreaded(*this));
+
+	// More rows than a parallel batch
+	const FString CSV = MakeVectorCSV(10000);
+	UScriptStruct& Struct = *TBaseStructure<FVector>::Get();
+
+	TArray<FVector> SerialRows;
+	FRecordingOutput SerialOutput;
+	const Serialization::EImportResult SerialResult = Serialization::ImportFromCSV(
+		Struct,
+		CSV,
+		[&SerialRows](const void* Data) { SerialRows.Emplace(*static_cast<const FVector*>(Data)); },
+		&SerialOutput);
+
+	TArray<FVector> ParallelRows;
+	FRecordingOutput ParallelOutput;
+	const Serialization::EImportResult ParallelResult = Serialization::ImportFromCSV(
+		Struct,
+		CSV,
+		[&ParallelRows](const void* Data) { ParallelRows.Emplace(*static_cast<const FVector*>(Data)); },
+		&ParallelOutput,
+		nullptr,
+		Serialization::EImportFlags::Parallel);
+
+	TestTrue("Same result", SerialResult == ParallelResult);
+	TestEqual("Broken rows skipped", SerialRows.Num(), 9000);
+	TestTrue("Same rows in the same order", SerialRows == ParallelRows);
+	TestTrue("Same messages in the same order", SerialOutput.Messages == ParallelOutput.Messages);
+}
+
+ZKZ_ADD_TEST(UnorderedParallelImportDeliversAllRows)
+{
+	ZKZ_RETURN_IF(SkipIfNotThreaded(*this));
+
+	const FString CSV = MakeVectorCSV(10000);
+
+	FCriticalSection CriticalSection;
+	TArray<FVector> Rows;
+	FRecordingOutput Output;
+	const Serialization::EImportResult Result = Serialization::ImportFromCSV(
+		*TBaseStructure<FVector>::Get(),
+		CSV,
+		[&](const void* Data)
+		{
+			FScopeLock Lock{&CriticalSection};
+			Rows.Emplace(*static_cast<const FVector*>(Data));
+		},
+		&Output,
+		nullptr,
+		Serialization::EImportFlags::Parallel | Serialization::EImportFlags::UnorderedCallback);
+
+	TestTrue("Broken rows reported", Result == Serialization::EImportResult::Warning);
+	TestEqual("Messages for broken rows", Output.Messages.Num(), 1000);
+
+	Rows.Sort([](const FVector& A, const FVector& B) { return A.X < B.X; });
+	TestEqual("All rows delivered", Rows.Num(), 9000);
+	TestEqual("Row content", Rows.Last(), FVector{9998.0, 19996.0, 0.0});
+}
+
+ZKZ_END_AUTOMATION_TEST(FSerializationTest);
+
+}  // namespace Zkz::Test
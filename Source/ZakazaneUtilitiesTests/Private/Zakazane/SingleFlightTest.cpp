@@ -0,0 +1,92 @@
+#include "Zakazane/SingleFlight.h"
+#include "Zakazane/Test/Test.h"
+
+namespace Zkz::Test
+{
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FSingleFlightTest,
+	"Zakazane.ZakazaneUtilities.SingleFlight",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(ConcurrentRequestsShareProducer)
+{
+	TSingleFlight<int, int> SingleFlight{-1};
+
+	int NumProducerCalls = 0;
+	TPromise<int> ProducerPromise;
+	const auto Producer = [&NumProducerCalls, &ProducerPromise]
+	{
+		++NumProducerCalls;
+		return ProducerPromise.GetFuture();
+	};
+
+	const TFuture<int> First = SingleFlight.Request(1, Producer);
+	const TFuture<int> Second = SingleFlight.Request(1, Producer);
+
+	TestEqual("ProducerCalledOnce", NumProducerCalls, 1);
+	TestTrue("KeyInFlight", SingleFlight.IsInFlight(1));
+
+	ProducerPromise.SetValue(42);
+
+	TestFalse("KeyNoLongerInFlight", SingleFlight.IsInFlight(1));
+	TestEqual("FirstRequestFulfilled", First.Get(), 42);
+	TestEqual("SecondRequestFulfilled", Second.Get(), 42);
+	TestEqual("NothingCachedByDefault", SingleFlight.GetNumCachedValues(), 0);
+
+	const TFuture<int> Third =
+		SingleFlight.Request(1, [&NumProducerCalls] { return MakeFulfilledPromise<int>(++NumProducerCalls).GetFuture(); });
+	TestEqual("ProducerCalledAgainAfterCompletion", NumProducerCalls, 2);
+	TestEqual("ThirdRequestFulfilled", Third.Get(), 2);
+}
+
+ZKZ_ADD_TEST(DifferentKeysUseSeparateProducers)
+{
+	TSingleFlight<FName, int> SingleFlight{-1};
+
+	const TFuture<int> A = SingleFlight.Request("A", [] { return MakeFulfilledPromise<int>(1).GetFuture(); });
+	const TFuture<int> B = SingleFlight.Request("B", [] { return MakeFulfilledPromise<int>(2).GetFuture(); });
+
+	TestEqual("FirstKeyValue", A.Get(), 1);
+	TestEqual("SecondKeyValue", B.Get(), 2);
+}
+
+ZKZ_ADD_TEST(CachedValuesAreReused)
+{
+	TSingleFlight<int, int> SingleFlight{-1, FSingleFlightCachePolicy{.TimeToLive = 3600.0, .MaxNumCachedValues = 2}};
+
+	int NumProducerCalls = 0;
+	const auto Producer = [&NumProducerCalls] { return MakeFulfilledPromise<int>(++NumProducerCalls).GetFuture(); };
+
+	TestEqual("FirstRequestProduces", SingleFlight.Request(1, Producer).Get(), 1);
+	TestEqual("SecondRequestIsCached", SingleFlight.Request(1, Producer).Get(), 1);
+	TestEqual("ProducerCalledOnce", NumProducerCalls, 1);
+
+	SingleFlight.Invalidate(1);
+	TestEqual("InvalidatedRequestProduces", SingleFlight.Request(1, Producer).Get(), 2);
+
+	SingleFlight.Request(2, Producer);
+	SingleFlight.Request(3, Producer);
+	TestEqual("CacheIsBounded", SingleFlight.GetNumCachedValues(), 2);
+	TestEqual("OldestValueEvicted", SingleFlight.Request(1, Producer).Get(), 5);
+}
+
+ZKZ_ADD_TEST(DestructionSetsCancelledValue)
+{
+	TPromise<int> ProducerPromise;
+
+	TFuture<int> Future;
+	{
+		TSingleFlight<int, int> SingleFlight{-1};
+		Future = SingleFlight.Request(1, [&ProducerPromise] { return ProducerPromise.GetFuture(); });
+	}
+
+	TestTrue("FutureReadyAfterDestruction", Future.IsReady());
+	TestEqual("CancelledValuePresentInFuture", Future.Get(), -1);
+
+	ProducerPromise.SetValue(42);
+}
+
+ZKZ_END_AUTOMATION_TEST(FSingleFlightTest);
+
+}  // namespace Zkz::Test
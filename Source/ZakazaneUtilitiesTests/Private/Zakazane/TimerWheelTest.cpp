@@ -0,0 +1,116 @@
+#include "Zakazane/TimerWheel.h"
+#include "Zakazane/Test/Test.h"
+
+namespace Zkz::Test
+{
+
+ZKZ_BEGIN_AUTOMATION_TEST(
+	FTimerWheelTest,
+	"Zakazane.ZakazaneUtilities.TimerWheel",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+ZKZ_ADD_TEST(CallbacksCalledAfterDelay)
+{
+	FTimerWheel TimerWheel{1.0};
+
+	TArray<int32> Fired;
+	TimerWheel.Schedule(3.0, [&Fired] { Fired.Emplace(3); });
+	TimerWheel.Schedule(1.0, [&Fired] { Fired.Emplace(1); });
+	TimerWheel.Schedule(0.0, [&Fired] { Fired.Emplace(0); });
+	TimerWheel.Schedule(2.5, [&Fired] { Fired.Emplace(2); });
+	TestEqual("AllPending", TimerWheel.GetNumPending(), 4);
+
+	TimerWheel.Advance(0.5);
+	TestTrue("NothingFiredBeforeFirstTick", Fired.IsEmpty());
+
+	TimerWheel.Advance(0.5);
+	TestEqual("ZeroDelayFiresAfterOneTick", Fired, {1, 0});
+
+	TimerWheel.Advance(2.0);
+	TestEqual("DelayRoundedUpToTicks", Fired, {1, 0, 3, 2});
+	TestEqual("NonePending", TimerWheel.GetNumPending(), 0);
+}
+
+ZKZ_ADD_TEST(DistantTimersCascade)
+{
+	FTimerWheel TimerWheel{1.0};
+
+	// Spread across all wheel levels: 64 slots per level
+	const TArray<int32> Delays{5, 63, 64, 65, 100, 4095, 4096, 5000, 262143, 262144, 300000};
+
+	TArray<int32> Fired;
+	for (const int32 Delay : Delays)
+	{
+		TimerWheel.Schedule(Delay, [&Fired, Delay] { Fired.Emplace(Delay); });
+	}
+
+	int32 NumTicks = 0;
+	TArray<int32> FiredAtTick;
+	while (TimerWheel.GetNumPending() > 0 && NumTicks < 400000)
+	{
+		const int32 NumFiredBefore = Fired.Num();
+		TimerWheel.Advance(1.0);
+		++NumTicks;
+
+		for (int32 Idx = NumFiredBefore; Idx < Fired.Num(); ++Idx)
+		{
+			FiredAtTick.Emplace(NumTicks);
+		}
+	}
+
+	TestEqual("AllFiredInOrder", Fired, Delays);
+	TestEqual("AllFiredOnTime", FiredAtTick, Delays);
+}
+
+ZKZ_ADD_TEST(TimersBeyondTopLevelOverflow)
+{
+	FTimerWheel TimerWheel{1.0};
+
+	// The four levels of 64 slots span 64^4 ticks, later timers are kept aside and re-placed once per top level cycle
+	constexpr double TopLevelSpan = 64.0 * 64.0 * 64.0 * 64.0;
+	const TArray<double> Delays{TopLevelSpan + 5.0, 2.0 * TopLevelSpan + 3.0};
+
+	TArray<double> Fired;
+	for (const double Delay : Delays)
+	{
+		TimerWheel.Schedule(Delay, [&Fired, Delay] { Fired.Emplace(Delay); });
+	}
+
+	TimerWheel.Advance(TopLevelSpan + 4.0);
+	TestTrue("NotFiredBeforeDelay", Fired.IsEmpty());
+
+	TimerWheel.Advance(1.0);
+	TestEqual("FiredAfterOneCycle", Fired, {Delays[0]});
+
+	TimerWheel.Advance(TopLevelSpan - 3.0);
+	TestEqual("SecondNotFiredBeforeDelay", Fired.Num(), 1);
+
+	TimerWheel.Advance(1.0);
+	TestEqual("FiredAfterTwoCycles", Fired, Delays);
+	TestEqual("NonePending", TimerWheel.GetNumPending(), 0);
+}
+
+ZKZ_ADD_TEST(CallbacksMayScheduleTimers)
+{
+	FTimerWheel TimerWheel{1.0};
+
+	int32 NumFired = 0;
+	TimerWheel.Schedule(
+		1.0,
+		[&NumFired, &TimerWheel]
+		{
+			++NumFired;
+			TimerWheel.Schedule(1.0, [&NumFired] { ++NumFired; });
+		});
+
+	TimerWheel.Advance(1.0);
+	TestEqual("FirstFired", NumFired, 1);
+	TestEqual("RescheduledPending", TimerWheel.GetNumPending(), 1);
+
+	TimerWheel.Advance(1.0);
+	TestEqual("RescheduledFired", NumFired, 2);
+}
+
+ZKZ_END_AUTOMATION_TEST(FTimerWheelTest);
+
+}  // namespace Zkz::Test